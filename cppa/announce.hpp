@@ -31,10 +31,15 @@
 #ifndef CPPA_ANNOUNCE_HPP
 #define CPPA_ANNOUNCE_HPP
 
+#include <vector>
 #include <typeinfo>
 
 #include "cppa/uniform_type_info.hpp"
 #include "cppa/util/abstract_uniform_type_info.hpp"
+
+#include "cppa/detail/tuple_vals.hpp"
+#include "cppa/detail/types_array.hpp"
+#include "cppa/detail/fused_uniform_type_info_impl.hpp"
 #include "cppa/detail/default_uniform_type_info_impl.hpp"
 
 namespace cppa {
@@ -163,6 +168,60 @@ inline bool announce(const Args&... args) {
                     new detail::default_uniform_type_info_impl<T>(args...));
 }
 
+/**
+ * @brief Adds a new type mapping for @p T to the libcppa type system
+ *        using a serializer generated at compile time.
+ *
+ * Unlike <tt>announce<T>(members...)</tt>, this serializer accesses
+ * all members directly instead of using a meta object per member.
+ * If all members are integers, @p float or @p double, a binary
+ * serializer writes a @p T as a single packed block and a vector of
+ * @p T as one block of packed values.
+ * @param members Member pointers to all members of @p T.
+ * @pre All members are primitive types, i.e., one of the types
+ *      listed in {@link primitive_type}.
+ * @note Vectors of @p T are serialized without type names per element
+ *       and thus all nodes must announce @p T using this function.
+ * @returns @c true if @p T was added to the libcppa type system,
+ *          @c false otherwise.
+ */
+template<typename T, typename... Ms>
+inline bool announce_fused(Ms T::*... members) {
+    typedef detail::fused_uniform_type_info_impl<T, Ms...> impl;
+    return announce(typeid(T), new impl(members...));
+}
+
+/**
+ * @brief Adds a factory for tuples with the element types @p types.
+ * @param types Element types of the message signature.
+ * @param factory Creates a default constructed tuple of @p types.
+ * @param move_element Moves the element at the position given by its first
+ *                     argument from its third to its second argument.
+ * @returns @c true if the signature was added, @c false if
+ *          it was announced before or @p types is invalid.
+ */
+bool announce_tuple(const std::vector<const uniform_type_info*>& types,
+                    detail::abstract_tuple* (*factory)(),
+                    void (*move_element)(size_t, void*, void*));
+
+/**
+ * @brief Announces the message signature <tt>{T...}</tt>.
+ *
+ * Messages of this signature received from other nodes are deserialized
+ * into a single, statically typed tuple instead of a tuple of separately
+ * allocated objects and take the statically typed path in pattern matching.
+ * @pre All types in @p T are announced.
+ * @returns @c true if the signature was added, @c false otherwise.
+ */
+template<typename... T>
+inline bool announce_tuple() {
+    auto& arr = detail::static_types_array<T...>::arr;
+    return announce_tuple(std::vector<const uniform_type_info*>(arr.begin(),
+                                                                arr.end()),
+                          &detail::new_tuple_vals<T...>,
+                          &detail::move_tuple_vals_element<T...>);
+}
+
 /**
  * @}
  */
@@ -31,10 +31,19 @@
 #ifndef CPPA_BINARY_DESERIALIZER_HPP
 #define CPPA_BINARY_DESERIALIZER_HPP
 
+#include <cstdint>
+
+#include "cppa/ref_counted.hpp"
 #include "cppa/deserializer.hpp"
+#include "cppa/intrusive_ptr.hpp"
+#include "cppa/binary_format.hpp"
+
+#include "cppa/util/blob.hpp"
 
 namespace cppa {
 
+class type_lookup_table;
+
 /**
  * @brief Implements the deserializer interface with
  *        a binary serialization protocol.
@@ -45,14 +54,22 @@ class binary_deserializer : public deserializer {
 
  public:
 
+    /**
+     * @brief Creates a binary deserializer reading from @p buf.
+     *
+     * If @p incoming_types is not @p nullptr, type names are expected
+     * to be encoded as numeric ids (see {@link binary_serializer}).
+     */
     binary_deserializer(const char* buf, size_t buf_size,
-                        actor_addressing* addressing = nullptr);
+                        actor_addressing* addressing = nullptr,
+                        type_lookup_table* incoming_types = nullptr);
 
     binary_deserializer(const char* begin, const char* end,
-                        actor_addressing* addressing = nullptr);
+                        actor_addressing* addressing = nullptr,
+                        type_lookup_table* incoming_types = nullptr);
 
-    std::string seek_object();
-    std::string peek_object();
+    const std::string& seek_object();
+    const std::string& peek_object();
     void begin_object(const std::string& type_name);
     void end_object();
     size_t begin_sequence();
@@ -62,11 +79,73 @@ class binary_deserializer : public deserializer {
                     const primitive_type* ptypes,
                     primitive_variant* storage);
     void read_raw(size_t num_bytes, void* storage);
+    void read_array(primitive_type ptype, size_t num, void* storage);
+
+    /**
+     * @brief Reads a value of type @p T directly into @p storage
+     *        without using a {@link primitive_variant}.
+     * @note @p T must be a primitive type, i.e., one of the types
+     *       listed in {@link primitive_type}.
+     */
+    template<typename T>
+    void read(T& storage);
+
+    /**
+     * @brief Reads a value of type @p T without using
+     *        a {@link primitive_variant}.
+     */
+    template<typename T>
+    inline T read() {
+        T result;
+        read(result);
+        return result;
+    }
+
+    /**
+     * @brief Sets the wire format, a bitmask of
+     *        {@link binary_format_flag} values.
+     */
+    inline void format(std::uint32_t flags) { m_format = flags; }
+
+    inline std::uint32_t format() const { return m_format; }
+
+    /**
+     * @brief Sets the owner of the data this deserializer reads from.
+     *        Allows {@link read_blob()} to return slices of the data
+     *        instead of copies.
+     * @pre @p owner keeps the data alive and does not modify it.
+     */
+    inline void data_owner(intrusive_ptr<ref_counted> owner) {
+        m_owner = std::move(owner);
+    }
+
+    /**
+     * @brief Reads @p num_bytes bytes as a blob that shares
+     *        the data if a data owner is set.
+     */
+    util::blob read_blob(size_t num_bytes);
+
+    /**
+     * @brief Returns the number of bytes not read yet.
+     */
+    inline size_t remaining() const {
+        return static_cast<size_t>(end - pos);
+    }
 
  private:
 
     const char* pos;
     const char* end;
+    type_lookup_table* m_incoming_types;
+    std::uint32_t m_format;
+    intrusive_ptr<ref_counted> m_owner;
+    // type name read from the stream if it has no id yet
+    std::string m_type_name;
+
+    // sets @p result to the name stored in the table of incoming types
+    // if the stream refers to a known id, to m_type_name otherwise
+    const char* read_type_name(const char* first, const std::string*& result,
+                               bool add_to_types);
 
 };
 
@@ -0,0 +1,73 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_BINARY_FORMAT_HPP
+#define CPPA_BINARY_FORMAT_HPP
+
+#include <cstdint>
+
+namespace cppa {
+
+/**
+ * @brief Optional extensions of the binary serialization format used
+ *        by {@link binary_serializer} and {@link binary_deserializer}.
+ *
+ * The format is a bitmask of these flags. Serializer and deserializer
+ * must use the same format; network peers negotiate it on connect.
+ */
+enum binary_format_flag : std::uint32_t {
+    /**
+     * @brief Writes @p float and @p double as little-endian IEEE 754
+     *        values instead of decimal strings.
+     */
+    native_floats = 0x01,
+    /**
+     * @brief Writes integers, except 8-bit integers, as well as
+     *        sizes of sequences and strings as LEB128 varints.
+     *        Signed integers are zigzag encoded.
+     */
+    varint_integers = 0x02
+};
+
+/**
+ * @brief The format used by default. Varints trade CPU time
+ *        for size and thus are not enabled by default.
+ */
+constexpr std::uint32_t default_binary_format = native_floats;
+
+/**
+ * @brief The format of libcppa versions without format extensions.
+ */
+constexpr std::uint32_t legacy_binary_format = 0;
+
+} // namespace cppa
+
+#endif // CPPA_BINARY_FORMAT_HPP
@@ -31,13 +31,19 @@
 #ifndef CPPA_BINARY_SERIALIZER_HPP
 #define CPPA_BINARY_SERIALIZER_HPP
 
+#include <string>
+#include <vector>
 #include <utility>
+#include <cstdint>
 
 #include "cppa/serializer.hpp"
+#include "cppa/binary_format.hpp"
 #include "cppa/util/buffer.hpp"
 
 namespace cppa {
 
+class type_lookup_table;
+
 namespace detail { class binary_writer; }
 
 /**
@@ -52,9 +58,14 @@ class binary_serializer : public serializer {
 
     /**
      * @brief Creates a binary serializer writing to @p write_buffer.
+     *
+     * If @p outgoing_types is not @p nullptr, type names are written
+     * only once and replaced by numeric ids afterwards.
      * @warning @p write_buffer must be guaranteed to outlive @p this
      */
-    binary_serializer(util::buffer* write_buffer, actor_addressing* ptr = 0);
+    binary_serializer(util::buffer* write_buffer,
+                      actor_addressing* ptr = 0,
+                      type_lookup_table* outgoing_types = 0);
 
     void begin_object(const std::string& tname);
 
@@ -70,9 +81,50 @@ class binary_serializer : public serializer {
 
     void write_raw(size_t num_bytes, const void* data);
 
+    void write_array(primitive_type ptype, size_t num, const void* values);
+
+    /**
+     * @brief Writes @p value without boxing it into a
+     *        {@link primitive_variant}.
+     *
+     * Produces the same output as <tt>write_value(value)</tt>.
+     * @note @p T must be a primitive type, i.e., one of the types
+     *       listed in {@link primitive_type}.
+     */
+    template<typename T>
+    void write(const T& value);
+
+    /**
+     * @brief Sets the wire format, a bitmask of
+     *        {@link binary_format_flag} values.
+     */
+    inline void format(std::uint32_t flags) { m_format = flags; }
+
+    inline std::uint32_t format() const { return m_format; }
+
+    /**
+     * @brief A list of type names along with their position in the output.
+     */
+    typedef std::vector<std::pair<size_t, std::string> > type_name_list;
+
+    /**
+     * @brief Omits type names in the output and stores them in
+     *        @p names instead.
+     *
+     * Allows to write the same output to several connections with
+     * separate type dictionaries by inserting the type names afterwards
+     * using {@link begin_object()}. Positions are relative to the size
+     * of the buffer when calling this member function.
+     */
+    void collect_type_names(type_name_list* names);
+
  private:
 
     util::buffer* m_sink;
+    type_lookup_table* m_outgoing_types;
+    std::uint32_t m_format;
+    type_name_list* m_type_names;
+    size_t m_type_names_offset;
 
 };
 
@@ -52,6 +52,12 @@
 #  error Plattform and/or compiler not supportet
 #endif
 
+#define CPPA_CACHE_LINE_SIZE 64
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#  define CPPA_BIG_ENDIAN
+#endif
+
 #include <cstdio>
 #include <cstdlib>
 
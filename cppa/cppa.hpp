@@ -34,6 +34,7 @@
 #include <tuple>
 #include <chrono>
 #include <cstdint>
+#include <vector>
 #include <functional>
 #include <type_traits>
 
@@ -751,6 +752,26 @@ actor_ptr spawn(Args&&... args) {
     return get_scheduler()->spawn(ptr);
 }
 
+/**
+ * @brief Spawns @p num_instances actors of type @p ActorImpl.
+ *
+ * Each actor is constructed using a copy of @p args. This is
+ * more efficient than calling {@link spawn} @p num_instances times.
+ * @param num_instances Number of actors to spawn.
+ * @param args Optional constructor arguments.
+ * @tparam ActorImpl Subtype of {@link event_based_actor} or {@link sb_actor}.
+ * @returns An {@link actor_ptr} for each spawned {@link actor}.
+ */
+template<class ActorImpl, typename... Args>
+std::vector<actor_ptr> spawn_n(size_t num_instances, const Args&... args) {
+    std::vector<scheduled_actor*> ptrs;
+    ptrs.reserve(num_instances);
+    for (size_t i = 0; i < num_instances; ++i) {
+        ptrs.push_back(detail::memory::create<ActorImpl>(args...));
+    }
+    return get_scheduler()->spawn_n(std::move(ptrs));
+}
+
 /**
  * @brief Spawns an actor of type @p ActorImpl that joins @p grp immediately.
  * @param grp The group that the newly created actor shall join.
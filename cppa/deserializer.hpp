@@ -60,14 +60,16 @@ class deserializer {
     /**
      * @brief Seeks the beginning of the next object and return
      *        its uniform type name.
+     * @note The result remains valid until the next call to
+     *       {@link seek_object()} or {@link peek_object()}.
      */
-    virtual std::string seek_object() = 0;
+    virtual const std::string& seek_object() = 0;
 
     /**
      * @brief Equal to {@link seek_object()} but doesn't
      *        modify the internal in-stream position.
      */
-    virtual std::string peek_object() = 0;
+    virtual const std::string& peek_object() = 0;
 
     /**
      * @brief Begins deserialization of an object of type @p type_name.
@@ -125,6 +127,18 @@ class deserializer {
      */
     virtual void read_raw(size_t num_bytes, void* storage) = 0;
 
+    /**
+     * @brief Reads @p num values of type @p ptype into
+     *        the contiguous array @p storage.
+     *
+     * The default implementation calls {@link read_value()}
+     * for each element.
+     * @param ptype Type of the elements in @p storage.
+     * @param num Size of the array @p storage.
+     * @param storage Array of size @p num, storing the result of this function.
+     */
+    virtual void read_array(primitive_type ptype, size_t num, void* storage);
+
     inline actor_addressing* addressing() { return m_addressing; }
 
  private:
@@ -215,9 +215,12 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
             m_links.clear();
             m_attachables.clear();
         }
-        // send exit messages
-        for (actor_ptr& aptr : mlinks) {
-            aptr->enqueue(this, make_cow_tuple(atom("EXIT"), reason));
+        // send exit messages; all links share a single (immutable) tuple
+        if (mlinks.empty() == false) {
+            auto msg = make_any_tuple(atom("EXIT"), reason);
+            for (actor_ptr& aptr : mlinks) {
+                aptr->enqueue(this, msg);
+            }
         }
         for (attachable_ptr& ptr : mattachables) {
             ptr->actor_exited(reason);
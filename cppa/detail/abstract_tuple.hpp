@@ -83,6 +83,11 @@ class abstract_tuple : public ref_counted {
     // (default returns &typeid(void))
     virtual const std::type_info* type_token() const;
 
+    // uniquely identifies the element types of a dynamically typed tuple,
+    // i.e., all tuples with the same element types return the same token;
+    // returns nullptr if not supported by the implementation (default)
+    virtual const void* signature_token() const;
+
     bool equals(const abstract_tuple& other) const;
 
     typedef tuple_iterator<abstract_tuple> const_iterator;
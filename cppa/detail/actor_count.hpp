@@ -35,7 +35,7 @@
 
 namespace cppa { namespace detail {
 
-void inc_actor_count();
+void inc_actor_count(size_t num = 1);
 void dec_actor_count();
 
 /*
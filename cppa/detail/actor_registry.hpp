@@ -31,14 +31,17 @@
 #ifndef CPPA_ACTOR_REGISTRY_HPP
 #define CPPA_ACTOR_REGISTRY_HPP
 
-#include <map>
+#include <deque>
 #include <mutex>
+#include <chrono>
 #include <thread>
 #include <atomic>
 #include <cstdint>
+#include <unordered_map>
 #include <condition_variable>
 
 #include "cppa/actor.hpp"
+#include "cppa/config.hpp"
 #include "cppa/attachable.hpp"
 #include "cppa/util/shared_spinlock.hpp"
 
@@ -62,7 +65,10 @@ class actor_registry : public singleton_mixin<actor_registry> {
     typedef std::pair<actor_ptr, std::uint32_t> value_type;
 
     /**
-     * @brief Returns the {nullptr, invalid_exit_reason}.
+     * @brief Returns the entry for @p key. Returns
+     *        {nullptr, exit_reason::not_exited} for unknown actors and
+     *        {nullptr, exit_reason::unknown} for actors that finished
+     *        execution but whose entry was already reclaimed.
      */
     value_type get_entry(actor_id key) const;
 
@@ -73,17 +79,23 @@ class actor_registry : public singleton_mixin<actor_registry> {
 
     void put(actor_id key, const actor_ptr& value);
 
+    // marks the entry for @p key as exited (tombstone); the tombstone
+    // is reclaimed after the configured retention time
     void erase(actor_id key, std::uint32_t reason);
 
-    // gets the next free actor id
+    // sets how long the exit reason of a finished actor is kept, 60s per default
+    void tombstone_retention(std::chrono::milliseconds value);
+
+    // gets the next free actor id (from an ID block of the calling thread)
     actor_id next_id();
 
-    // increases running-actors-count by one
-    void inc_running();
+    // increases running-actors-count by @p num
+    void inc_running(size_t num = 1);
 
     // decreases running-actors-count by one
     void dec_running();
 
+    // aggregates the running-actors-count of all shards
     size_t running() const;
 
     // blocks the caller until running-actors-count becomes @p expected
@@ -91,16 +103,55 @@ class actor_registry : public singleton_mixin<actor_registry> {
 
  private:
 
-    typedef std::map<actor_id, value_type> entries;
+    typedef std::chrono::steady_clock clock_type;
+
+    // entries are split into shards, each shard has its own lock and
+    // a FIFO queue of its tombstones ordered by expiration time
+    struct entries_shard {
+        mutable util::shared_spinlock mtx;
+        std::unordered_map<actor_id, value_type> entries;
+        std::deque<std::pair<clock_type::time_point, actor_id> > tombstones;
+        char pad[CPPA_CACHE_LINE_SIZE];
+    };
+
+    static constexpr size_t num_entries_shards = 32;
+
+    inline entries_shard& shard_of(actor_id key) {
+        return m_entries[key % num_entries_shards];
+    }
+
+    inline const entries_shard& shard_of(actor_id key) const {
+        return m_entries[key % num_entries_shards];
+    }
+
+    // removes all expired tombstones from @p shard
+    // @pre shard.mtx is exclusively locked
+    void reclaim_tombstones(entries_shard& shard, clock_type::time_point now);
+
+    // the running-actors-count is split into shards that are assigned
+    // to threads round-robin; each shard counts started and finished
+    // actors separately, i.e., both counters grow monotonically
+    struct running_shard {
+        std::atomic<std::uint64_t> started;
+        std::atomic<std::uint64_t> finished;
+        char pad[CPPA_CACHE_LINE_SIZE - 2 * sizeof(std::atomic<std::uint64_t>)];
+        running_shard() : started(0), finished(0) { }
+    };
+
+    static constexpr size_t num_running_shards = 16;
+
+    running_shard& local_running_shard();
 
-    std::atomic<size_t> m_running;
+    running_shard m_running[num_running_shards];
+    // number of threads blocked in await_running_count_equal
+    std::atomic<size_t> m_awaiting;
     std::atomic<actor_id> m_ids;
 
     std::mutex m_running_mtx;
     std::condition_variable m_running_cv;
 
-    mutable util::shared_spinlock m_instances_mtx;
-    entries m_entries;
+    std::atomic<clock_type::rep> m_retention;
+    entries_shard m_entries[num_entries_shards];
 
     actor_registry();
 
@@ -31,11 +31,16 @@
 #ifndef CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 #define CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 
+#include <vector>
 #include <memory>
+#include <typeinfo>
+#include <algorithm>
 
 #include "cppa/anything.hpp"
 #include "cppa/serializer.hpp"
 #include "cppa/deserializer.hpp"
+#include "cppa/binary_serializer.hpp"
+#include "cppa/binary_deserializer.hpp"
 
 #include "cppa/util/rm_ref.hpp"
 #include "cppa/util/void_type.hpp"
@@ -47,6 +52,7 @@
 
 #include "cppa/detail/types_array.hpp"
 #include "cppa/detail/type_to_ptype.hpp"
+#include "cppa/detail/ptype_to_type.hpp"
 
 namespace cppa { namespace detail {
 
@@ -107,6 +113,15 @@ struct is_stl_pair : std::false_type { };
 template<typename F, typename S>
 struct is_stl_pair<std::pair<F,S> > : std::true_type { };
 
+// a contiguous container of integers or floating points that
+// can be serialized as a single block of memory
+template<typename T>
+struct is_primitive_array : std::false_type { };
+
+template<typename T, class Allocator>
+struct is_primitive_array<std::vector<T, Allocator> >
+: std::integral_constant<bool, type_to_ptype<T>::ptype <= pt_double> { };
+
 template<typename T>
 class builtin_member : public util::abstract_uniform_type_info<T> {
 
@@ -147,6 +162,31 @@ constexpr int impl_id() {
                     : 9)));
 }
 
+// a vector of user-defined types
+template<typename T>
+struct is_object_array : std::false_type { };
+
+template<typename T, class Allocator>
+struct is_object_array<std::vector<T, Allocator> >
+: std::integral_constant<bool,    impl_id<T>() == recursive_impl::value
+                               && !std::is_same<T, bool>::value> { };
+
+// implemented by type infos that write arrays of their type to a
+// binary_serializer at once, i.e., without per-element type names
+class bulk_serializable {
+
+ public:
+
+    virtual ~bulk_serializable() { }
+
+    virtual void serialize_array(const void* first, size_t num,
+                                 binary_serializer* sink) const = 0;
+
+    virtual void deserialize_array(void* first, size_t num,
+                                   binary_deserializer* source) const = 0;
+
+};
+
 template<typename T>
 struct deconst_pair {
     typedef T type;
@@ -178,18 +218,73 @@ class default_serialize_policy {
 
  private:
 
+    // T is exactly the type binary_serializer::write and
+    // binary_deserializer::read are instantiated for
+    template<typename T>
+    struct has_typed_access {
+        typedef typename ptype_to_type<type_to_ptype<T>::ptype>::type ptype;
+        typedef std::integral_constant<bool, std::is_same<T, ptype>::value> type;
+    };
+
     template<typename T>
     void simpl(const T& val, serializer* s, primitive_impl) const {
+        typename has_typed_access<T>::type token;
+        write_primitive(val, s, token);
+    }
+
+    // skips the primitive_variant if s is a binary_serializer
+    template<typename T>
+    void write_primitive(const T& val, serializer* s, std::true_type) const {
+        if (typeid(*s) == typeid(binary_serializer)) {
+            static_cast<binary_serializer*>(s)->write(val);
+        }
+        else s->write_value(val);
+    }
+
+    template<typename T>
+    void write_primitive(const T& val, serializer* s, std::false_type) const {
         s->write_value(val);
     }
 
     template<typename T>
     void simpl(const T& val, serializer* s, list_impl) const {
         s->begin_sequence(val.size());
+        std::integral_constant<bool, is_primitive_array<T>::value> token;
+        write_elements(val, s, token);
+        s->end_sequence();
+    }
+
+    template<typename T>
+    void write_elements(const T& val, serializer* s, std::true_type) const {
+        typedef typename T::value_type value_type;
+        s->write_array(type_to_ptype<value_type>::ptype, val.size(), val.data());
+    }
+
+    template<typename T>
+    void write_elements(const T& val, serializer* s, std::false_type) const {
+        std::integral_constant<bool, is_object_array<T>::value> token;
+        if (write_bulk(val, s, token)) return;
         for (auto i = val.begin(); i != val.end(); ++i) {
             (*this)(*i, s);
         }
-        s->end_sequence();
+    }
+
+    // returns false if the element type has no bulk serializer
+    template<typename T>
+    bool write_bulk(const T& val, serializer* s, std::true_type) const {
+        typedef typename T::value_type value_type;
+        if (typeid(*s) != typeid(binary_serializer)) return false;
+        auto uti = static_types_array<value_type>::arr[0];
+        auto bulk = dynamic_cast<const bulk_serializable*>(uti);
+        if (bulk == nullptr) return false;
+        bulk->serialize_array(val.data(), val.size(),
+                              static_cast<binary_serializer*>(s));
+        return true;
+    }
+
+    template<typename T>
+    bool write_bulk(const T&, serializer*, std::false_type) const {
+        return false;
     }
 
     template<typename T>
@@ -212,20 +307,84 @@ class default_serialize_policy {
 
     template<typename T>
     void dimpl(T& storage, deserializer* d, primitive_impl) const {
+        typename has_typed_access<T>::type token;
+        read_primitive(storage, d, token);
+    }
+
+    // skips the primitive_variant if d is a binary_deserializer
+    template<typename T>
+    void read_primitive(T& storage, deserializer* d, std::true_type) const {
+        if (typeid(*d) == typeid(binary_deserializer)) {
+            static_cast<binary_deserializer*>(d)->read(storage);
+        }
+        else storage = d->read<T>();
+    }
+
+    template<typename T>
+    void read_primitive(T& storage, deserializer* d, std::false_type) const {
         storage = d->read<T>();
     }
 
     template<typename T>
     void dimpl(T& storage, deserializer* d, list_impl) const {
-        typedef typename T::value_type value_type;
         storage.clear();
         size_t size = d->begin_sequence();
+        std::integral_constant<bool, is_primitive_array<T>::value> token;
+        read_elements(storage, size, d, token);
+        d->end_sequence();
+    }
+
+    template<typename T>
+    void read_elements(T& storage, size_t size,
+                       deserializer* d, std::true_type) const {
+        typedef typename T::value_type value_type;
+        // grows storage step by step, because a corrupted size
+        // must not cause a huge allocation before the deserializer
+        // runs out of data
+        for (size_t pos = 0; pos < size; ) {
+            auto num = std::min<size_t>(size - pos, 4096);
+            storage.resize(pos + num);
+            d->read_array(type_to_ptype<value_type>::ptype,
+                          num, storage.data() + pos);
+            pos += num;
+        }
+    }
+
+    template<typename T>
+    void read_elements(T& storage, size_t size,
+                       deserializer* d, std::false_type) const {
+        typedef typename T::value_type value_type;
+        std::integral_constant<bool, is_object_array<T>::value> token;
+        if (read_bulk(storage, size, d, token)) return;
         for (size_t i = 0; i < size; ++i) {
             value_type tmp;
             (*this)(tmp, d);
             storage.push_back(std::move(tmp));
         }
-        d->end_sequence();
+    }
+
+    template<typename T>
+    bool read_bulk(T& storage, size_t size,
+                   deserializer* d, std::true_type) const {
+        typedef typename T::value_type value_type;
+        if (typeid(*d) != typeid(binary_deserializer)) return false;
+        auto uti = static_types_array<value_type>::arr[0];
+        auto bulk = dynamic_cast<const bulk_serializable*>(uti);
+        if (bulk == nullptr) return false;
+        // grows storage step by step (see read_elements)
+        for (size_t pos = 0; pos < size; ) {
+            auto num = std::min<size_t>(size - pos, 4096);
+            storage.resize(pos + num);
+            bulk->deserialize_array(storage.data() + pos, num,
+                                    static_cast<binary_deserializer*>(d));
+            pos += num;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool read_bulk(T&, size_t, deserializer*, std::false_type) const {
+        return false;
     }
 
     template<typename T>
@@ -0,0 +1,315 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_FUSED_UNIFORM_TYPE_INFO_IMPL_HPP
+#define CPPA_FUSED_UNIFORM_TYPE_INFO_IMPL_HPP
+
+#include <tuple>
+#include <cstring>
+#include <typeinfo>
+#include <type_traits>
+
+#include "cppa/config.hpp"
+#include "cppa/serializer.hpp"
+#include "cppa/deserializer.hpp"
+#include "cppa/binary_format.hpp"
+#include "cppa/binary_serializer.hpp"
+#include "cppa/binary_deserializer.hpp"
+
+#include "cppa/util/abstract_uniform_type_info.hpp"
+
+#include "cppa/detail/type_to_ptype.hpp"
+#include "cppa/detail/ptype_to_type.hpp"
+#include "cppa/detail/default_uniform_type_info_impl.hpp"
+
+namespace cppa { namespace detail {
+
+// compile-time properties of a list of member types
+template<typename... Ms>
+struct fused_members;
+
+template<>
+struct fused_members<> {
+    static constexpr bool typed = true;
+    static constexpr bool fixed_size = true;
+    static constexpr bool has_floats = false;
+    static constexpr size_t packed_size = 0;
+};
+
+template<typename M, typename... Ms>
+struct fused_members<M, Ms...> {
+    typedef fused_members<Ms...> tail;
+    static constexpr primitive_type ptype = type_to_ptype<M>::ptype;
+    // M is exactly the type binary_serializer::write is instantiated for
+    static constexpr bool typed =    ptype != pt_null
+                                  && std::is_same<M, typename ptype_to_type<ptype>::type>::value
+                                  && tail::typed;
+    static constexpr bool fixed_size = ptype <= pt_double && tail::fixed_size;
+    static constexpr bool has_floats =    ptype == pt_float
+                                       || ptype == pt_double
+                                       || tail::has_floats;
+    static constexpr size_t packed_size = sizeof(M) + tail::packed_size;
+};
+
+struct fused_writer {
+    binary_serializer* sink;
+    template<typename M>
+    inline void operator()(const M& member) const { sink->write(member); }
+};
+
+struct fused_value_writer {
+    serializer* sink;
+    template<typename M>
+    inline void operator()(const M& member) const { sink->write_value(member); }
+};
+
+struct fused_reader {
+    binary_deserializer* source;
+    template<typename M>
+    inline void operator()(M& member) const { source->read(member); }
+};
+
+struct fused_value_reader {
+    deserializer* source;
+    template<typename M>
+    inline void operator()(M& member) const { member = source->read<M>(); }
+};
+
+struct fused_packer {
+    char* pos;
+    template<typename M>
+    inline void operator()(const M& member) {
+        memcpy(pos, &member, sizeof(M));
+        pos += sizeof(M);
+    }
+};
+
+struct fused_unpacker {
+    const char* pos;
+    template<typename M>
+    inline void operator()(M& member) {
+        memcpy(&member, pos, sizeof(M));
+        pos += sizeof(M);
+    }
+};
+
+// checks whether members are stored back-to-back in declaration order
+struct fused_layout_check {
+    const char* pos;
+    bool result;
+    template<typename M>
+    inline void operator()(const M& member) {
+        result = result && reinterpret_cast<const char*>(&member) == pos;
+        pos += sizeof(M);
+    }
+};
+
+/**
+ * @brief Serializes @p T by accessing its members @p Ms directly.
+ *
+ * Unlike {@link default_uniform_type_info_impl}, members are not
+ * wrapped into separate type infos, i.e., (de)serializing a @p T
+ * needs no virtual function call per member. If all members are
+ * integers, @p float or @p double, a binary_serializer writes them as
+ * a single packed block whenever its format produces the same output.
+ */
+template<typename T, typename... Ms>
+class fused_uniform_type_info_impl : public util::abstract_uniform_type_info<T>
+                                   , public bulk_serializable {
+
+    typedef fused_members<Ms...> members;
+
+    static_assert(sizeof...(Ms) > 0, "no members given");
+
+    static_assert(members::typed, "all members must be primitive types");
+
+    static constexpr size_t packed_size = members::packed_size;
+
+    typedef std::integral_constant<bool, members::fixed_size> packable;
+
+ public:
+
+    fused_uniform_type_info_impl(Ms T::*... ptrs) : m_members(ptrs...) {
+        check_layout(packable{});
+    }
+
+    void serialize(const void* ptr, serializer* s) const {
+        auto& obj = *reinterpret_cast<const T*>(ptr);
+        s->begin_object(this->name());
+        if (typeid(*s) == typeid(binary_serializer)) {
+            auto bs = static_cast<binary_serializer*>(s);
+            serialize_array(&obj, 1, bs);
+        }
+        else {
+            fused_value_writer f{s};
+            apply<0>(obj, f);
+        }
+        s->end_object();
+    }
+
+    void deserialize(void* ptr, deserializer* d) const {
+        auto& obj = *reinterpret_cast<T*>(ptr);
+        this->assert_type_name(d);
+        d->begin_object(this->name());
+        if (typeid(*d) == typeid(binary_deserializer)) {
+            auto bd = static_cast<binary_deserializer*>(d);
+            deserialize_array(&obj, 1, bd);
+        }
+        else {
+            fused_value_reader f{d};
+            apply<0>(obj, f);
+        }
+        d->end_object();
+    }
+
+    void serialize_array(const void* first, size_t num,
+                         binary_serializer* sink) const {
+        auto objs = reinterpret_cast<const T*>(first);
+        write_array(objs, num, sink, packable{});
+    }
+
+    void deserialize_array(void* first, size_t num,
+                           binary_deserializer* source) const {
+        auto objs = reinterpret_cast<T*>(first);
+        read_array(objs, num, source, packable{});
+    }
+
+ private:
+
+    // number of elements (un)packed at once on the stack
+    static constexpr size_t chunk_size = packed_size < 4096
+                                         ? 4096 / packed_size
+                                         : 1;
+
+    // applies f to each member of obj in declaration order
+    template<size_t I, typename Obj, typename F>
+    inline typename std::enable_if<I == sizeof...(Ms)>::type
+    apply(Obj&, F&) const { }
+
+    template<size_t I, typename Obj, typename F>
+    inline typename std::enable_if<(I < sizeof...(Ms))>::type
+    apply(Obj& obj, F& f) const {
+        f(obj.*std::get<I>(m_members));
+        apply<I + 1>(obj, f);
+    }
+
+    void check_layout(std::true_type) {
+        T obj;
+        fused_layout_check f{reinterpret_cast<const char*>(&obj), true};
+        apply<0>(const_cast<const T&>(obj), f);
+        m_contiguous =    f.result
+                       && packed_size == sizeof(T)
+                       && std::is_trivially_copyable<T>::value;
+    }
+
+    void check_layout(std::false_type) {
+        m_contiguous = false;
+    }
+
+    // a packed block has the same layout as separately written members
+    // if integers are written as is and floats are in native byte order
+    static inline bool is_packed(std::uint32_t format) {
+        if (format & varint_integers) return false;
+        if (members::has_floats) {
+#           ifdef CPPA_BIG_ENDIAN
+            return false;
+#           else
+            return (format & native_floats) != 0;
+#           endif
+        }
+        return true;
+    }
+
+    void write_array(const T* objs, size_t num,
+                     binary_serializer* sink, std::true_type) const {
+        if (!is_packed(sink->format())) {
+            write_array(objs, num, sink, std::false_type{});
+        }
+        else if (m_contiguous) {
+            sink->write_raw(num * sizeof(T), objs);
+        }
+        else {
+            char buf[chunk_size * packed_size];
+            for (size_t pos = 0; pos < num; ) {
+                auto n = (num - pos < chunk_size) ? num - pos : chunk_size;
+                fused_packer f{buf};
+                for (auto i = objs + pos; i != objs + pos + n; ++i) {
+                    apply<0>(*i, f);
+                }
+                sink->write_raw(n * packed_size, buf);
+                pos += n;
+            }
+        }
+    }
+
+    void write_array(const T* objs, size_t num,
+                     binary_serializer* sink, std::false_type) const {
+        fused_writer f{sink};
+        for (auto i = objs; i != objs + num; ++i) apply<0>(*i, f);
+    }
+
+    void read_array(T* objs, size_t num,
+                    binary_deserializer* source, std::true_type) const {
+        if (!is_packed(source->format())) {
+            read_array(objs, num, source, std::false_type{});
+        }
+        else if (m_contiguous) {
+            source->read_raw(num * sizeof(T), objs);
+        }
+        else {
+            char buf[chunk_size * packed_size];
+            for (size_t pos = 0; pos < num; ) {
+                auto n = (num - pos < chunk_size) ? num - pos : chunk_size;
+                source->read_raw(n * packed_size, buf);
+                fused_unpacker f{buf};
+                for (auto i = objs + pos; i != objs + pos + n; ++i) {
+                    apply<0>(*i, f);
+                }
+                pos += n;
+            }
+        }
+    }
+
+    void read_array(T* objs, size_t num,
+                    binary_deserializer* source, std::false_type) const {
+        fused_reader f{source};
+        for (auto i = objs; i != objs + num; ++i) apply<0>(*i, f);
+    }
+
+    std::tuple<Ms T::*...> m_members;
+
+    // T can be copied as a whole from and to a packed block
+    bool m_contiguous;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_FUSED_UNIFORM_TYPE_INFO_IMPL_HPP
@@ -0,0 +1,102 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_LAZY_TUPLE_HPP
+#define CPPA_LAZY_TUPLE_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include "cppa/any_tuple.hpp"
+#include "cppa/type_lookup_table.hpp"
+
+#include "cppa/util/blob.hpp"
+#include "cppa/util/shared_spinlock.hpp"
+
+#include "cppa/detail/abstract_tuple.hpp"
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief A tuple in binary form that is deserialized on first access,
+ *        i.e., by the thread processing it rather than the one receiving it.
+ *
+ * The data must not contain references to actors, groups, or channels,
+ * since those require an actor addressing, and must not introduce new
+ * type names. A tuple that cannot be deserialized is empty.
+ */
+class lazy_tuple : public abstract_tuple {
+
+    typedef abstract_tuple super;
+
+ public:
+
+    /**
+     * @param data The serialized tuple as written by a binary_serializer.
+     * @param format The binary format of @p data.
+     * @param types Resolves type ids in @p data, may be @p nullptr.
+     */
+    lazy_tuple(util::blob data,
+               std::uint32_t format,
+               std::shared_ptr<type_lookup_table> types);
+
+    void* mutable_at(size_t pos);
+
+    size_t size() const;
+
+    abstract_tuple* copy() const;
+
+    const void* at(size_t pos) const;
+
+    const uniform_type_info* type_at(size_t pos) const;
+
+    const void* signature_token() const;
+
+ private:
+
+    const abstract_tuple& get() const;
+
+    // deserializes m_data into m_tuple
+    void materialize() const;
+
+    mutable util::blob m_data;
+    std::uint32_t m_format;
+    mutable std::shared_ptr<type_lookup_table> m_types;
+
+    mutable std::atomic<bool> m_ready;
+    mutable util::shared_spinlock m_mtx;
+    mutable any_tuple m_tuple;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_LAZY_TUPLE_HPP
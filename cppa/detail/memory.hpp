@@ -32,23 +32,39 @@
 #define CPPA_MEMORY_HPP
 
 #include <new>
+#include <mutex>
 #include <vector>
+#include <cstddef>
 #include <utility>
 #include <typeinfo>
+#include <algorithm>
+#include <type_traits>
 
+#include "cppa/util/shared_spinlock.hpp"
 #include "cppa/detail/recursive_queue_node.hpp"
 
 namespace cppa { namespace detail {
 
 namespace {
 
-constexpr size_t s_alloc_size = 1024;  // allocate ~1kb chunks
-constexpr size_t s_cache_size = 10240; // cache about 10kb per thread
+constexpr size_t s_alloc_size = 1024;    // allocate ~1kb chunks
+constexpr size_t s_cache_size = 10240;   // cache about 10kb per thread
+constexpr size_t s_pool_size  = 1048576; // recycle about 1mb per actor type
 
 } // namespace <anonymous>
 
 class recursive_queue_node;
 
+/**
+ * @brief Causes instances of @p T to be recycled via a pool shared by
+ *        all threads in addition to the cache of each thread. Types whose
+ *        instances are usually released by another thread than the one
+ *        that created them specialize this trait, since that thread's
+ *        cache would never refill otherwise. Enabled for actors by default.
+ */
+template<typename T>
+struct use_recycling_pool : std::is_base_of<actor, T> { };
+
 class instance_wrapper {
 
  public:
@@ -61,6 +77,10 @@ class instance_wrapper {
     // releases memory
     virtual void deallocate() = 0;
 
+    // hands the memory over to the cache of its type
+    // of the calling thread
+    virtual void recycle() = 0;
+
 };
 
 class memory_cache {
@@ -82,6 +102,65 @@ class memory_cache {
 template<typename T>
 class basic_memory_cache : public memory_cache {
 
+    struct wrapper;
+
+    // number of instances a thread keeps in its local cache
+    static constexpr size_t max_cached = s_cache_size / sizeof(T);
+
+    // number of instances a thread moves from or to the pool at once
+    static constexpr size_t fetch_size = (max_cached > 0) ? max_cached : 1;
+
+    // recycle instances via a pool shared by all threads if
+    // they are usually created and released by different threads
+    static constexpr bool use_pool = use_recycling_pool<T>::value;
+
+    class recycling_pool {
+
+     public:
+
+        // moves the last @p num elements of @p storage to the pool
+        // and releases those exceeding its capacity
+        void push(std::vector<wrapper*>& storage, size_t num) {
+            auto first = storage.end() - static_cast<std::ptrdiff_t>(num);
+            auto i = first;
+            { // lifetime scope of guard
+                std::lock_guard<util::shared_spinlock> guard(m_lock);
+                auto n = std::min(num, max_elements - m_elements.size());
+                m_elements.insert(m_elements.end(), i,
+                                  i + static_cast<std::ptrdiff_t>(n));
+                i += static_cast<std::ptrdiff_t>(n);
+            }
+            for (; i != storage.end(); ++i) (*i)->deallocate();
+            storage.erase(first, storage.end());
+        }
+
+        // moves up to @p num elements to @p storage
+        void pop(std::vector<wrapper*>& storage, size_t num) {
+            std::lock_guard<util::shared_spinlock> guard(m_lock);
+            auto n = std::min(num, m_elements.size());
+            auto first = m_elements.end() - static_cast<std::ptrdiff_t>(n);
+            storage.insert(storage.end(), first, m_elements.end());
+            m_elements.erase(first, m_elements.end());
+        }
+
+     private:
+
+        static constexpr size_t max_elements = (s_pool_size / sizeof(T) > 0)
+                                               ? s_pool_size / sizeof(T)
+                                               : 1;
+
+        util::shared_spinlock m_lock;
+        std::vector<wrapper*> m_elements;
+
+    };
+
+    static recycling_pool& pool() {
+        // never destroyed, since threads may still release
+        // instances while static objects are destroyed
+        static recycling_pool* instance = new recycling_pool;
+        return *instance;
+    }
+
     struct wrapper : instance_wrapper {
         ref_counted* parent;
         union { T instance; };
@@ -89,6 +168,7 @@ class basic_memory_cache : public memory_cache {
         ~wrapper() { }
         void destroy() { instance.~T(); }
         void deallocate() { parent->deref(); }
+        void recycle();
     };
 
     class storage : public ref_counted {
@@ -111,7 +191,12 @@ class basic_memory_cache : public memory_cache {
 
      private:
 
-        wrapper data[s_alloc_size / sizeof(T)];
+        // allocate at least one instance per chunk, since actor
+        // implementations easily exceed s_alloc_size
+        static constexpr size_t num_elements =
+                (sizeof(T) < s_alloc_size) ? s_alloc_size / sizeof(T) : 1;
+
+        wrapper data[num_elements];
 
     };
 
@@ -120,10 +205,13 @@ class basic_memory_cache : public memory_cache {
     std::vector<wrapper*> cached_elements;
 
     basic_memory_cache() {
-        cached_elements.reserve(s_cache_size / sizeof(T));
+        cached_elements.reserve(max_cached + (use_pool ? fetch_size : 0));
     }
 
     ~basic_memory_cache() {
+        if (use_pool && !cached_elements.empty()) {
+            pool().push(cached_elements, cached_elements.size());
+        }
         for (auto e : cached_elements) e->deallocate();
     }
 
@@ -138,11 +226,30 @@ class basic_memory_cache : public memory_cache {
         CPPA_REQUIRE(ptr->outer_memory != nullptr);
         auto wptr = static_cast<wrapper*>(ptr->outer_memory);
         wptr->destroy();
-        if (cached_elements.capacity() > 0) cached_elements.push_back(wptr);
+        cache(wptr);
+    }
+
+    // stores a destroyed instance for re-use
+    void cache(wrapper* wptr) {
+        if (use_pool) {
+            cached_elements.push_back(wptr);
+            // keep max_cached elements after handing over a batch
+            if (cached_elements.size() >= max_cached + fetch_size) {
+                pool().push(cached_elements,
+                            cached_elements.size() - max_cached);
+            }
+        }
+        else if (cached_elements.size() < max_cached) {
+            cached_elements.push_back(wptr);
+        }
         else wptr->deallocate();
     }
 
     virtual std::pair<instance_wrapper*,void*> new_instance() {
+        if (use_pool && cached_elements.empty()) {
+            // re-use instances released by other threads if possible
+            pool().pop(cached_elements, fetch_size);
+        }
         if (cached_elements.empty()) {
             auto elements = new storage;
             for (auto i = elements->begin(); i != elements->end(); ++i) {
@@ -198,10 +305,12 @@ class memory {
         auto mc = get_cache_map_entry(&typeid(*ptr));
         if (mc) mc->release_instance(mc->downcast(ptr));
         else {
+            // the calling thread has no cache for this type yet,
+            // e.g., a worker thread releasing an actor
             auto wptr = ptr->outer_memory;
             if (wptr) {
                 wptr->destroy();
-                wptr->deallocate();
+                wptr->recycle();
             }
             else delete ptr;
         }
@@ -225,6 +334,12 @@ class memory {
 
 };
 
+template<typename T>
+void basic_memory_cache<T>::wrapper::recycle() {
+    auto mc = memory::get_or_set_cache_map_entry<T>();
+    static_cast<basic_memory_cache*>(mc)->cache(this);
+}
+
 struct disposer {
     template<typename T>
     void operator()(T* ptr) {
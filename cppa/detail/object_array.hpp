@@ -31,6 +31,7 @@
 #ifndef CPPA_OBJECT_ARRAY_HPP
 #define CPPA_OBJECT_ARRAY_HPP
 
+#include <atomic>
 #include <vector>
 
 #include "cppa/object.hpp"
@@ -47,8 +48,8 @@ class object_array : public abstract_tuple {
     using abstract_tuple::const_iterator;
 
     object_array();
-    object_array(object_array&&) = default;
-    object_array(const object_array&) = default;
+    object_array(object_array&&);
+    object_array(const object_array&);
 
     void push_back(object&& what);
 
@@ -66,10 +67,15 @@ class object_array : public abstract_tuple {
 
     const uniform_type_info* type_at(size_t pos) const;
 
+    const void* signature_token() const;
+
  private:
 
     std::vector<object> m_elements;
 
+    // lazily initialized by signature_token()
+    mutable std::atomic<const void*> m_signature;
+
 };
 
 } } // namespace cppa::detail
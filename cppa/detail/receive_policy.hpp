@@ -236,9 +236,9 @@ class receive_policy {
                 CPPA_REQUIRE(!message_id.valid());
                 if (client->m_trap_exit == false) {
                     if (v1 != exit_reason::normal) {
-                        // TODO: check for possible memory leak here
-                        // ('node' might not get destroyed)
+                        // throws actor_exited unless client is event-based
                         client->quit(v1);
+                        return non_normal_exit_signal;
                     }
                     return normal_exit_signal;
                 }
@@ -342,6 +342,11 @@ class receive_policy {
                 // - expired_timeout_message
                 return hm_drop_msg;
             }
+            case non_normal_exit_signal: {
+                // client did quit without throwing an exception,
+                // stop processing messages
+                return hm_msg_handled;
+            }
             case timeout_message: {
                 handle_timeout(client, fun);
                 if (awaited_response.valid()) {
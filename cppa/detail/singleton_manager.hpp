@@ -72,6 +72,8 @@ class singleton_manager {
 
     static network::middleman* get_middleman();
 
+    static bool set_middleman(network::middleman*);
+
     static uniform_type_info_map* get_uniform_type_info_map();
 
     static abstract_tuple* get_tuple_dummy();
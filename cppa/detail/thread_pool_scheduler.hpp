@@ -66,6 +66,9 @@ class thread_pool_scheduler : public scheduler {
                     init_callback init_cb,
                     scheduling_hint hint);
 
+    std::vector<actor_ptr> spawn_n(std::vector<scheduled_actor*> what,
+                                   scheduling_hint hint);
+
     actor_ptr spawn(void_function fun,
                     scheduling_hint hint);
 
@@ -126,6 +126,27 @@ class tuple_vals : public abstract_tuple {
 template<typename... ElementTypes>
 types_array<ElementTypes...> tuple_vals<ElementTypes...>::m_types;
 
+template<typename T>
+void move_tuple_element(void* storage, void* from) {
+    *reinterpret_cast<T*>(storage) = std::move(*reinterpret_cast<T*>(from));
+}
+
+// creates a default constructed tuple, used to deserialize
+// messages with announced signatures (see announce_tuple)
+template<typename... ElementTypes>
+abstract_tuple* new_tuple_vals() {
+    return new tuple_vals<ElementTypes...>;
+}
+
+// moves the element at position @p pos from @p from to @p storage, both
+// pointing to an instance of the element type at @p pos
+template<typename... ElementTypes>
+void move_tuple_vals_element(size_t pos, void* storage, void* from) {
+    typedef void (*move_fun)(void*, void*);
+    static const move_fun funs[] = {&move_tuple_element<ElementTypes>...};
+    funs[pos](storage, from);
+}
+
 template<typename TypeList>
 struct tuple_vals_from_type_list;
 
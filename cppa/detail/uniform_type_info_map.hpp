@@ -31,9 +31,19 @@
 #ifndef CPPA_UNIFORM_TYPE_INFO_MAP_HPP
 #define CPPA_UNIFORM_TYPE_INFO_MAP_HPP
 
+#include <map>
 #include <set>
+#include <mutex>
+#include <atomic>
 #include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <typeinfo>
 #include <utility> // std::pair
+#include <unordered_map>
+
+#include "cppa/util/shared_spinlock.hpp"
 
 #include "cppa/detail/singleton_mixin.hpp"
 #include "cppa/detail/default_uniform_type_info_impl.hpp"
@@ -42,6 +52,7 @@ namespace cppa { class uniform_type_info; }
 
 namespace cppa { namespace detail {
 
+class abstract_tuple;
 class uniform_type_info_map_helper;
 
 // note: this class is implemented in uniform_type_info.cpp
@@ -53,9 +64,32 @@ class uniform_type_info_map : public singleton_mixin<uniform_type_info_map> {
  public:
 
     typedef std::set<std::string> set_type;
-    typedef std::map<std::string, uniform_type_info*> uti_map_type;
+    typedef std::unordered_map<std::string, uniform_type_info*> uti_map_type;
     typedef std::map<int, std::pair<set_type, set_type> > int_map_type;
 
+    // creates and fills statically typed tuples of an announced signature
+    struct tuple_factory {
+        // creates a default constructed tuple
+        abstract_tuple* (*create)();
+        // moves the element at a given position from its
+        // third to its second argument
+        void (*move_element)(size_t, void*, void*);
+    };
+
+    // node of the trie of announced signatures, keyed by the tuple size
+    // followed by the type id of each element; nodes are immutable once
+    // published, announcing a signature copies the path to its leaf
+    struct tuple_factory_node {
+        // set if an announced signature ends at this node
+        tuple_factory factory;
+        // a signature ending below this node, i.e., a tuple that can
+        // hold all elements read until reaching this node
+        tuple_factory candidate;
+        std::map<std::uint32_t, const tuple_factory_node*> children;
+        tuple_factory_node() : factory{nullptr, nullptr}
+                             , candidate{nullptr, nullptr} { }
+    };
+
     inline const int_map_type& int_names() const {
         return m_ints;
     }
@@ -64,11 +98,36 @@ class uniform_type_info_map : public singleton_mixin<uniform_type_info_map> {
 
     const uniform_type_info* by_uniform_name(const std::string& name) const;
 
+    // lock-free lookup by address of the type_info, falls back
+    // to by_raw_name() for type_info objects not seen before
+    const uniform_type_info* by_type_info(const std::type_info& tinfo) const;
+
+    const uniform_type_info* by_id(std::uint32_t id) const;
+
     std::vector<const uniform_type_info*> get_all() const;
 
     // NOT thread safe!
     bool insert(const std::set<std::string>& raw_names, uniform_type_info* uti);
 
+    // registers a factory for tuples with given element types
+    bool insert_tuple_factory(const std::vector<const uniform_type_info*>& types,
+                              tuple_factory factory);
+
+    // returns the root of the trie or nullptr if no signature was
+    // announced; nodes are never released before this map, i.e.,
+    // a trie can be traversed without locking
+    inline const tuple_factory_node* tuple_factories() const {
+        return m_tuple_factories.load(std::memory_order_acquire);
+    }
+
+    // returns the child of @p node for @p key or nullptr
+    static inline const tuple_factory_node*
+    tuple_factory_child(const tuple_factory_node* node, std::uint32_t key) {
+        if (node == nullptr) return nullptr;
+        auto i = node->children.find(key);
+        return i != node->children.end() ? i->second : nullptr;
+    }
+
  private:
 
     // maps raw typeid names to uniform type informations
@@ -80,6 +139,36 @@ class uniform_type_info_map : public singleton_mixin<uniform_type_info_map> {
     // maps sizeof(-integer_type-) to { signed-names-set, unsigned-names-set }
     int_map_type m_ints;
 
+    // maps type ids to uniform type informations
+    std::vector<uniform_type_info*> m_by_id;
+
+    // root of the current trie of announced signatures
+    std::atomic<const tuple_factory_node*> m_tuple_factories{nullptr};
+
+    // all nodes of the current and previous tries
+    std::vector<std::unique_ptr<tuple_factory_node> > m_tuple_factory_nodes;
+
+    // serializes announcements of signatures
+    std::mutex m_tuple_factories_mtx;
+
+    // must be a power of two
+    static constexpr size_t cache_size = 1024;
+
+    // maximum number of probed slots per lookup
+    static constexpr size_t max_probes = 16;
+
+    // caches by_raw_name results by type_info addresses;
+    // an entry is valid once its value has been set
+    struct cache_entry {
+        std::atomic<const std::type_info*> key;
+        std::atomic<const uniform_type_info*> value;
+    };
+
+    mutable cache_entry m_cache[cache_size];
+
+    void add_to_cache(const std::type_info* key,
+                      const uniform_type_info* value) const;
+
     uniform_type_info_map();
 
     ~uniform_type_info_map();
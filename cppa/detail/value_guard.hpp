@@ -95,8 +95,29 @@ class value_guard {
         return _eval(m_args.head, m_args.tail(), args...);
     }
 
+    /**
+     * @brief Stores the value the first argument is compared to
+     *        in @p storage if it is of type @p T.
+     * @returns @p true if a value was stored, otherwise @p false.
+     */
+    template<typename T>
+    inline bool leading_value(T& storage) const {
+        return fetch(storage, m_args.head);
+    }
+
  private:
 
+    template<typename T>
+    static inline bool fetch(T& storage, const T& value) {
+        storage = value;
+        return true;
+    }
+
+    template<typename T, typename U>
+    static inline bool fetch(T&, const U&) {
+        return false;
+    }
+
     typename tdata_from_type_list<FilteredPattern>::type m_args;
 
     template<typename T, typename U>
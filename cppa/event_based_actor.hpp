@@ -82,6 +82,13 @@ class event_based_actor : public detail::abstract_scheduled_actor {
      */
     virtual void init() = 0;
 
+    /**
+     * @brief Finishes execution with exit reason @p reason.
+     *
+     * Unlike other actor implementations, event-based actors do not
+     * throw {@link actor_exited} to leave the current message handler.
+     * The handler returns normally and the actor is not resumed afterwards.
+     */
     void quit(std::uint32_t reason = exit_reason::normal);
 
     void unbecome();
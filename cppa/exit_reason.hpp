@@ -57,6 +57,12 @@ static constexpr std::uint32_t unhandled_exception = 0x00002;
  */
 static constexpr std::uint32_t unallowed_function_call = 0x00003;
 
+/**
+ * @brief Indicates that an actor finished execution but its
+ *        original exit reason is no longer available.
+ */
+static constexpr std::uint32_t unknown = 0x00004;
+
 /**
  * @brief Indicates that an actor finishied execution
  *        because a connection to a remote link was
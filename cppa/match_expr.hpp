@@ -31,6 +31,12 @@
 #ifndef CPPA_MATCH_EXPR_HPP
 #define CPPA_MATCH_EXPR_HPP
 
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "cppa/atom.hpp"
 #include "cppa/option.hpp"
 #include "cppa/guard_expr.hpp"
 #include "cppa/partial_function.hpp"
@@ -113,8 +119,10 @@ struct invoke_policy_impl<wildcard_position::nil,
     }
 
     template<class Tuple>
-    static bool can_invoke(const std::type_info& arg_types, const Tuple&) {
-        return arg_types == typeid(util::empty_type_list);
+    static bool can_invoke(const std::type_info& arg_types, const Tuple& tup) {
+        return    arg_types == typeid(util::empty_type_list)
+               || (tup.impl_type() == detail::dynamically_typed
+                   && tup.size() == 0);
     }
 
 };
@@ -222,8 +230,23 @@ struct invoke_policy_impl<wildcard_position::nil,
     }
 
     template<class Tuple>
-    static bool can_invoke(const std::type_info& arg_types, const Tuple&) {
-        return arg_types == typeid(filtered_pattern);
+    static bool can_invoke(const std::type_info& arg_types, const Tuple& tup) {
+        if (arg_types == typeid(filtered_pattern)) {
+            return true;
+        }
+        else if (tup.impl_type() == detail::dynamically_typed) {
+            auto& arr = arr_type::arr;
+            if (tup.size() != filtered_pattern::size) {
+                return false;
+            }
+            for (size_t i = 0; i < filtered_pattern::size; ++i) {
+                if (arr[i] != tup.type_at(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
     }
 
 };
@@ -485,10 +508,16 @@ struct pjf_same_pattern
 template<typename Data>
 struct invoke_helper3 {
     const Data& data;
-    invoke_helper3(const Data& mdata) : data(mdata) { }
+    std::uint64_t cases;
+    invoke_helper3(const Data& mdata, std::uint64_t mcases)
+    : data(mdata), cases(mcases) { }
     template<size_t P, typename T, typename... Args>
     inline bool operator()(util::type_pair<std::integral_constant<size_t,P>,T>,
                            Args&&... args) const {
+        if ((cases & (static_cast<std::uint64_t>(0x01) << P)) == 0) {
+            // ruled out by leading atom
+            return false;
+        }
         const auto& target = get<P>(data);
         return target.first(target.second, std::forward<Args>(args)...);
         //return (get<Pos>(data))(args...);
@@ -500,7 +529,9 @@ struct invoke_helper2 {
     typedef Pattern pattern_type;
     typedef typename util::tl_filter_not_type<Pattern,anything>::type arg_types;
     const Data& data;
-    invoke_helper2(const Data& mdata) : data(mdata) { }
+    std::uint64_t cases;
+    invoke_helper2(const Data& mdata, std::uint64_t mcases)
+    : data(mdata), cases(mcases) { }
     template<typename... Args>
     bool invoke(Args&&... args) const {
         typedef invoke_policy<Pattern> impl;
@@ -511,19 +542,36 @@ struct invoke_helper2 {
     bool operator()(Args&&... args) const {
         //static_assert(false, "foo");
         Token token;
-        invoke_helper3<Data> fun{data};
+        invoke_helper3<Data> fun{data, cases};
         return util::static_foreach<0, Token::size>
                ::eval_or(token, fun, std::forward<Args>(args)...);
     }
 };
 
+// computes a bitmask with all case indexes of a group
+template<class Token>
+struct case_bits;
+
+template<>
+struct case_bits<util::empty_type_list> {
+    static constexpr std::uint64_t value = 0;
+};
+
+template<class Head, typename... Tail>
+struct case_bits<util::type_list<Head, Tail...> > {
+    static constexpr std::uint64_t value =
+            (static_cast<std::uint64_t>(0x01) << Head::first::value)
+          | case_bits<util::type_list<Tail...> >::value;
+};
+
 // invokes a group of {projection, tpartial_function} pairs
 template<typename Data>
 struct invoke_helper {
     const Data& data;
     std::uint64_t bitfield;
-    invoke_helper(const Data& mdata, std::uint64_t bits)
-    : data(mdata), bitfield(bits) { }
+    std::uint64_t cases;
+    invoke_helper(const Data& mdata, std::uint64_t bits, std::uint64_t mcases)
+    : data(mdata), bitfield(bits), cases(mcases) { }
     // token: type_list<type_pair<integral_constant<size_t, X>,
     //                            std::pair<projection, tpartial_function>>,
     //                  ...>
@@ -533,15 +581,17 @@ struct invoke_helper {
     bool operator()(Token, Args&&... args) {
         typedef typename Token::head type_pair;
         typedef typename type_pair::second leaf_pair;
-        if (bitfield & 0x01) {
+        bool enabled = (bitfield & 0x01) != 0;
+        // shift *before* invoking, otherwise a group that is enabled
+        // but doesn't match would shift all following bits by one
+        bitfield >>= 1;
+        if (enabled && (cases & case_bits<Token>::value) != 0) {
             // next invocation step
             invoke_helper2<Data,
                            Token,
-                           typename leaf_pair::pattern_type> fun{data};
+                           typename leaf_pair::pattern_type> fun{data, cases};
             return fun.invoke(std::forward<Args>(args)...);
         }
-        bitfield >>= 1;
-        //++enabled;
         return false;
     }
 };
@@ -556,12 +606,44 @@ struct can_invoke_helper {
         typedef typename type_pair::second leaf_pair;
         typedef invoke_policy<typename leaf_pair::pattern_type> impl;
         if (impl::can_invoke(std::forward<Args>(args)...)) {
-            bitfield |= (0x01 << i);
+            bitfield |= (static_cast<std::uint64_t>(0x01) << i);
         }
         ++i;
     }
 };
 
+template<class Guard>
+inline bool leading_atom(const Guard&, atom_value&) {
+    return false;
+}
+
+template<class FilteredPattern>
+inline bool leading_atom(const value_guard<FilteredPattern>& guard,
+                         atom_value& storage) {
+    return guard.leading_value(storage);
+}
+
+// collects the constant leading atoms of all cases
+struct leading_atoms_helper {
+    std::pair<atom_value, std::uint64_t>* atoms;
+    size_t& num_atoms;
+    std::uint64_t& others;
+    size_t i;
+    leading_atoms_helper(std::pair<atom_value, std::uint64_t>* a,
+                         size_t& n, std::uint64_t& o)
+    : atoms(a), num_atoms(n), others(o), i(0) { }
+    template<class Case>
+    void operator()(const Case& c) {
+        auto bit = static_cast<std::uint64_t>(0x01) << i++;
+        atom_value value;
+        if (   std::is_same<typename Case::pattern_type::head, atom_value>::value
+            && leading_atom(c.second.guard(), value)) {
+            atoms[num_atoms++] = std::make_pair(value, bit);
+        }
+        else others |= bit;
+    }
+};
+
 template<typename T>
 struct is_manipulator_case {
     static constexpr bool value = T::second_type::manipulates_args;
@@ -617,16 +699,17 @@ class match_expr {
             util::tl_exists<cases_list, detail::is_manipulator_case>::value;
 
     template<typename... Args>
-    match_expr(Args&&... args) : m_cases(std::forward<Args>(args)...) {
-        init();
+    match_expr(Args&&... args)
+    : m_cases(std::forward<Args>(args)...), m_cached(0), m_atoms_ready(false) {
     }
 
-    match_expr(match_expr&& other) : m_cases(std::move(other.m_cases)) {
-        init();
+    match_expr(match_expr&& other)
+    : m_cases(std::move(other.m_cases)), m_cached(0) {
+        copy_atoms(other);
     }
 
-    match_expr(const match_expr& other) : m_cases(other.m_cases) {
-        init();
+    match_expr(const match_expr& other) : m_cases(other.m_cases), m_cached(0) {
+        copy_atoms(other);
     }
 
     bool invoke(const any_tuple& tup) {
@@ -690,7 +773,9 @@ class match_expr {
                 ptr_type;
 
         eval_order token;
-        detail::invoke_helper<decltype(m_cases)> fun{m_cases, enabled_begin};
+        detail::invoke_helper<decltype(m_cases)> fun{m_cases,
+                                                     enabled_begin,
+                                                     get_case_mask(tup)};
         return util::static_foreach<0, eval_order::size>
                 ::eval_or(token,
                           fun,
@@ -743,48 +828,85 @@ class match_expr {
     //                   ...>
     detail::tdata<Cases...> m_cases;
 
-    static constexpr size_t cache_size = 10;
-    //typedef std::array<bool, eval_order::size> cache_entry;
-    //typedef typename cache_entry::iterator cache_entry_iterator;
-    //typedef std::pair<const std::type_info*, cache_entry> cache_element;
-
     // std::uint64_t is used as a bitmask to enable/disable groups
 
-    typedef std::pair<const std::type_info*, std::uint64_t> cache_element;
+    // keys are either type tokens of statically typed tuples or
+    // signature tokens of dynamically typed tuples
+
+    typedef std::pair<const void*, std::uint64_t> cache_element;
 
-    util::fixed_vector<cache_element, cache_size> m_cache;
+    // initial number of slots, must be a power of two
+    static constexpr size_t min_cache_size = 8;
 
-    // ring buffer like access to m_cache
-    size_t m_cache_begin;
-    size_t m_cache_end;
+    // open addressing hash table (linear probing) using type tokens as keys;
+    // grows whenever it becomes half full, i.e., the cache is never evicted
+    // and each type token runs can_invoke_helper only once; allocated on
+    // the first invocation, because most instances are short-lived copies
+    std::vector<cache_element> m_cache;
 
-    cache_element m_dummy;
+    // number of used slots in m_cache
+    size_t m_cached;
 
-    static inline void advance_(size_t& i) {
-        i = (i + 1) % cache_size;
+    static inline size_t hash_of(const void* token) {
+        // tokens are (at least) word aligned, i.e.,
+        // the lower bits are always zero
+        auto x = reinterpret_cast<std::uintptr_t>(token);
+        return static_cast<size_t>((x >> 4) ^ (x >> 12));
     }
 
-    inline size_t find_token_pos(const std::type_info* type_token) {
-        for (size_t i = m_cache_begin ; i != m_cache_end; advance_(i)) {
-            if (m_cache[i].first == type_token) return i;
+    // returns either the position of token or the first empty slot
+    inline size_t find_token_pos(const void* token) const {
+        auto mask = m_cache.size() - 1;
+        auto i = hash_of(token) & mask;
+        while (m_cache[i].first != nullptr && m_cache[i].first != token) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    static inline const void* cache_key(const std::type_info* type_token,
+                                        const detail::abstract_tuple& tup) {
+        return (tup.impl_type() == detail::dynamically_typed)
+               ? tup.signature_token()
+               : type_token;
+    }
+
+    template<class Tuple>
+    static inline const void* cache_key(const std::type_info* type_token,
+                                        const Tuple&) {
+        return type_token;
+    }
+
+    void grow_cache() {
+        std::vector<cache_element> tmp(std::max(m_cache.size() * 2,
+                                                min_cache_size),
+                                       cache_element{nullptr, 0});
+        m_cache.swap(tmp);
+        for (auto& entry : tmp) {
+            if (entry.first) m_cache[find_token_pos(entry.first)] = entry;
         }
-        return m_cache_end;
     }
 
     template<class Tuple>
     std::uint64_t get_cache_entry(const std::type_info* type_token,
                                   const Tuple& value) {
         CPPA_REQUIRE(type_token != nullptr);
-        if (value.impl_type() == detail::dynamically_typed) {
-            return m_dummy.second; // all groups enabled
+        auto key = cache_key(type_token, value);
+        if (key == nullptr) {
+            // dynamically typed tuple without signature token
+            return std::numeric_limits<std::uint64_t>::max();
         }
-        size_t i = find_token_pos(type_token);
+        if (m_cache.empty()) grow_cache();
+        size_t i = find_token_pos(key);
         // if we didn't found a cache entry ...
-        if (i == m_cache_end) {
-            // ... 'create' one (override oldest element in cache if full)
-            advance_(m_cache_end);
-            if (m_cache_end == m_cache_begin) advance_(m_cache_begin);
-            m_cache[i].first = type_token;
+        if (m_cache[i].first == nullptr) {
+            // ... create one (keep load factor <= 0.5)
+            if ((m_cached + 1) * 2 > m_cache.size()) {
+                grow_cache();
+                i = find_token_pos(key);
+            }
+            ++m_cached;
+            m_cache[i].first = key;
             m_cache[i].second = 0;
             eval_order token;
             detail::can_invoke_helper fun{m_cache[i].second};
@@ -794,11 +916,109 @@ class match_expr {
         return m_cache[i].second;
     }
 
-    void init() {
-        m_dummy.second = std::numeric_limits<std::uint64_t>::max();
-        m_cache.resize(cache_size);
-        for (auto& entry : m_cache) { entry.first = nullptr; }
-        m_cache_begin = m_cache_end = 0;
+    typedef std::pair<atom_value, std::uint64_t> atom_entry;
+
+    // sorted by atom value; maps the leading atom of a message to all
+    // cases that could match it, i.e., behaviors dispatching on
+    // on(atom("..."), ...) need a single binary search instead of
+    // evaluating each value guard in turn; the atoms are stored in the
+    // value guards of m_cases, thus the table is built on the first
+    // invocation and copied along with the cases afterwards
+    std::array<atom_entry, sizeof...(Cases)> m_atoms;
+
+    // number of used entries in m_atoms
+    size_t m_num_atoms;
+
+    // cases without a constant leading atom
+    std::uint64_t m_others;
+
+    bool m_atoms_ready;
+
+    inline void copy_atoms(const match_expr& other) {
+        m_atoms_ready = other.m_atoms_ready;
+        if (m_atoms_ready) {
+            m_atoms = other.m_atoms;
+            m_num_atoms = other.m_num_atoms;
+            m_others = other.m_others;
+        }
+    }
+
+    // returns false if no case has a constant leading atom
+    inline bool has_atoms() {
+        if (!m_atoms_ready) init_atoms();
+        return m_num_atoms > 0;
+    }
+
+    std::uint64_t lookup_atom(atom_value value) const {
+        auto last = m_atoms.begin() + m_num_atoms;
+        auto i = std::lower_bound(m_atoms.begin(), last, value,
+                                  [](const atom_entry& e, atom_value x) {
+                                      return e.first < x;
+                                  });
+        return (i != last && i->first == value) ? i->second : m_others;
+    }
+
+    // dynamically typed tuples
+    template<class Tuple>
+    std::uint64_t get_case_mask(const Tuple& tup) {
+        if (!has_atoms()) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        if (   tup.size() == 0
+            || tup.type_at(0) != detail::static_types_array<atom_value>::arr[0]) {
+            return m_others;
+        }
+        return lookup_atom(*reinterpret_cast<const atom_value*>(tup.at(0)));
+    }
+
+    // statically typed tuples; the lookup is selected at compile time
+    template<typename... Ts>
+    std::uint64_t get_case_mask(const detail::tdata<Ts...>& tup) {
+        typedef typename util::rm_ref<
+                    typename detail::tdata<Ts...>::types::head
+                >::type
+                head_type;
+        if (!has_atoms()) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        return get_case_mask(tup, std::is_same<head_type, atom_value>{});
+    }
+
+    template<typename... Ts>
+    std::uint64_t get_case_mask(const detail::tdata<Ts...>& tup,
+                                std::true_type) const {
+        return lookup_atom(*reinterpret_cast<const atom_value*>(tup.at(0)));
+    }
+
+    template<typename... Ts>
+    inline std::uint64_t get_case_mask(const detail::tdata<Ts...>&,
+                                       std::false_type) const {
+        return m_others;
+    }
+
+    void init_atoms() {
+        m_atoms_ready = true;
+        m_num_atoms = 0;
+        m_others = 0;
+        detail::leading_atoms_helper fun{m_atoms.data(), m_num_atoms, m_others};
+        util::static_foreach<0, sizeof...(Cases)>::_(m_cases, fun);
+        if (m_num_atoms == 0) return;
+        auto first = m_atoms.begin();
+        std::sort(first, first + m_num_atoms,
+                  [](const atom_entry& lhs, const atom_entry& rhs) {
+                      return lhs.first < rhs.first;
+                  });
+        // merge cases with the same leading atom
+        auto last = first;
+        for (auto i = first + 1; i != first + m_num_atoms; ++i) {
+            if (i->first == last->first) last->second |= i->second;
+            else *(++last) = *i;
+        }
+        m_num_atoms = static_cast<size_t>(last - first) + 1;
+        // cases without leading atom might match as well
+        for (auto i = first; i != first + m_num_atoms; ++i) {
+            i->second |= m_others;
+        }
     }
 
     template<typename AbstractTuple, typename NativeDataPtr>
@@ -806,7 +1026,9 @@ class match_expr {
         const std::type_info* type_token = vals.type_token();
         auto bitfield = get_cache_entry(type_token, vals);
         eval_order token;
-        detail::invoke_helper<decltype(m_cases)> fun{m_cases, bitfield};
+        detail::invoke_helper<decltype(m_cases)> fun{m_cases,
+                                                     bitfield,
+                                                     get_case_mask(vals)};
         return util::static_foreach<0, eval_order::size>
                ::eval_or(token,
                          fun,
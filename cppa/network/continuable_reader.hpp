@@ -38,6 +38,8 @@
 
 #include "cppa/network/protocol.hpp"
 
+namespace cppa { namespace util { class buffer; } }
+
 namespace cppa { namespace network {
 
 class middleman;
@@ -52,6 +54,26 @@ enum continue_reading_result {
     read_continue_later
 };
 
+/**
+ * @brief Denotes how an event loop using completion-based I/O performs
+ *        input on behalf of a {@link continuable_reader}.
+ */
+enum class completion_mode {
+    /**
+     * @brief The reader reads from its handle once it is readable.
+     */
+    none,
+    /**
+     * @brief The event loop reads from the handle into
+     *        {@link continuable_reader::read_buffer()}.
+     */
+    read,
+    /**
+     * @brief The event loop accepts connections on the handle.
+     */
+    accept
+};
+
 class continuable_io;
 
 /**
@@ -71,6 +93,32 @@ class continuable_reader : public ref_counted {
      */
     virtual continue_reading_result continue_reading() = 0;
 
+    /**
+     * @brief Returns whether an event loop using completion-based I/O
+     *        may read or accept on {@link read_handle()} on behalf of
+     *        this object. The default implementation returns
+     *        {@link completion_mode::none}.
+     */
+    virtual completion_mode completion() const;
+
+    /**
+     * @brief Returns the buffer the event loop appends received data to.
+     * @pre <tt>completion() == completion_mode::read</tt> and
+     *      <tt>read_buffer()->remaining() > 0</tt>
+     */
+    virtual util::buffer* read_buffer();
+
+    /**
+     * @brief Called after the event loop appended @p num_bytes to
+     *        {@link read_buffer()}; zero bytes denote a closed connection.
+     */
+    virtual continue_reading_result read_completed(size_t num_bytes);
+
+    /**
+     * @brief Called after the event loop accepted the connection @p fd.
+     */
+    virtual continue_reading_result accepted(native_socket_type fd);
+
     /**
      * @brief Casts @p this to a continuable_io or returns @p nullptr
      *        if cast fails.
@@ -83,6 +131,19 @@ class continuable_reader : public ref_counted {
      */
      virtual void io_failed() = 0;
 
+    /**
+     * @brief Returns the index of the middleman event loop
+     *        handling this object.
+     */
+    inline size_t loop_id() const { return m_loop_id; }
+
+    /**
+     * @brief Assigns this object to another middleman event loop.
+     * @note Must not be changed while this object is registered
+     *       as reader or writer.
+     */
+    inline void loop_id(size_t id) { m_loop_id = id; }
+
  protected:
 
     continuable_reader(native_socket_type read_fd);
@@ -90,6 +151,7 @@ class continuable_reader : public ref_counted {
  private:
 
     native_socket_type m_rd;
+    size_t m_loop_id;
 
 };
 
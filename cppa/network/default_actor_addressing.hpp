@@ -38,10 +38,17 @@
 #include "cppa/actor_addressing.hpp"
 #include "cppa/process_information.hpp"
 
+#include "cppa/util/shared_spinlock.hpp"
+
 namespace cppa { namespace network {
 
 class default_protocol;
 
+/**
+ * @brief Manages the proxies of remote actors. Member functions are
+ *        thread-safe, since each middleman event loop deserializes
+ *        actor addresses of arbitrary nodes.
+ */
 class default_actor_addressing : public actor_addressing {
 
  public:
@@ -67,7 +74,8 @@ class default_actor_addressing : public actor_addressing {
              actor_id aid,
              const actor_proxy_ptr& proxy);
 
-    proxy_map& proxies(process_information& from);
+    // returns a copy of all proxies for given parent
+    proxy_map proxies(process_information& from);
 
     void erase(process_information& info);
 
@@ -75,8 +83,12 @@ class default_actor_addressing : public actor_addressing {
 
  private:
 
+    // sends a MONITOR message for aid to node
+    void monitor(const process_information& node, actor_id aid);
+
     default_protocol* m_parent;
     process_information_ptr m_pinf;
+    util::shared_spinlock m_lock;
     std::map<process_information,proxy_map> m_proxies;
 
 };
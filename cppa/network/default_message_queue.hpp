@@ -34,6 +34,7 @@
 #include "cppa/any_tuple.hpp"
 #include "cppa/ref_counted.hpp"
 #include "cppa/network/message_header.hpp"
+#include "cppa/network/serialized_payload.hpp"
 
 namespace cppa { namespace network {
 
@@ -41,7 +42,15 @@ class default_message_queue : public ref_counted {
 
  public:
 
-    typedef std::pair<message_header,any_tuple> value_type;
+    struct value_type {
+        message_header hdr;
+        any_tuple msg;
+        // msg serialized by the sender or nullptr
+        serialized_payload_ptr payload;
+        value_type(message_header h, any_tuple m,
+                   serialized_payload_ptr p = nullptr)
+        : hdr(std::move(h)), msg(std::move(m)), payload(std::move(p)) { }
+    };
 
     typedef value_type& reference;
 
@@ -32,19 +32,28 @@
 #define CPPA_DEFAULT_PEER_IMPL_HPP
 
 #include <map>
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <vector>
 #include <cstdint>
 
+#include "cppa/ref_counted.hpp"
 #include "cppa/actor_proxy.hpp"
+#include "cppa/intrusive_ptr.hpp"
 #include "cppa/partial_function.hpp"
 #include "cppa/weak_intrusive_ptr.hpp"
 #include "cppa/process_information.hpp"
 
+#include "cppa/type_lookup_table.hpp"
+
 #include "cppa/util/buffer.hpp"
 
 #include "cppa/network/input_stream.hpp"
 #include "cppa/network/output_stream.hpp"
 #include "cppa/network/continuable_reader.hpp"
 #include "cppa/network/continuable_io.hpp"
+#include "cppa/network/serialized_payload.hpp"
 #include "cppa/network/default_message_queue.hpp"
 
 namespace cppa { namespace network {
@@ -59,20 +68,37 @@ class default_peer : public continuable_io {
 
  public:
 
+    /**
+     * @param offered_features Wire features announced to the remote node
+     *                         in a @p FEATURES message right after the
+     *                         handshake or @p 0 if none were announced.
+     */
     default_peer(default_protocol* parent,
                  const input_stream_ptr& in,
                  const output_stream_ptr& out,
-                 process_information_ptr peer_ptr = nullptr);
+                 process_information_ptr peer_ptr = nullptr,
+                 std::uint32_t offered_features = 0);
 
     continue_reading_result continue_reading();
 
+    completion_mode completion() const;
+
+    util::buffer* read_buffer();
+
+    continue_reading_result read_completed(size_t num_bytes);
+
     continue_writing_result continue_writing();
 
     continuable_io* as_io();
 
     void io_failed();
 
-    void enqueue(const message_header& hdr, const any_tuple& msg);
+    /**
+     * @param payload @p msg serialized by the sender or @p nullptr.
+     */
+    void enqueue(const message_header& hdr,
+                 const any_tuple& msg,
+                 const serialized_payload_ptr& payload = nullptr);
 
     inline bool erase_on_last_proxy_exited() const {
         return m_erase_on_last_proxy_exited;
@@ -86,6 +112,14 @@ class default_peer : public continuable_io {
         return m_has_unwritten_data;
     }
 
+    /**
+     * @brief Returns whether further messages should remain in the
+     *        message queue until this peer was able to write.
+     */
+    inline bool write_buffer_full() const {
+        return m_unwritten_bytes >= m_flush_bytes;
+    }
+
  protected:
 
     ~default_peer();
@@ -107,14 +141,116 @@ class default_peer : public continuable_io {
     input_stream_ptr m_in;
     output_stream_ptr m_out;
     read_state m_state;
+    // the message currently read is deserialized by its receiver
+    bool m_lazy_payload;
     process_information_ptr m_node;
     bool m_has_unwritten_data;
 
     const uniform_type_info* m_meta_hdr;
     const uniform_type_info* m_meta_msg;
 
-    util::buffer m_rd_buf;
-    util::buffer m_wr_buf;
+    // received messages can refer to their frame (see util::blob),
+    // thus the read buffer is reference counted
+    struct rd_frame : ref_counted {
+        util::buffer buf;
+    };
+
+    typedef intrusive_ptr<rd_frame> rd_frame_ptr;
+
+    rd_frame_ptr m_rd_frame;
+
+    // frames still shared with received messages, reused once released
+    std::vector<rd_frame_ptr> m_shared_frames;
+
+    inline util::buffer& rd_buf() {
+        return m_rd_frame->buf;
+    }
+
+    // replaces m_rd_frame, which is still shared with received messages
+    void recycle_rd_frame();
+
+    // number of bytes of the read buffer that were already parsed
+    size_t m_rd_pos;
+
+    // size of the message currently read
+    std::uint32_t m_msg_size;
+
+    // parses all complete frames in the read buffer
+    continue_reading_result read_frames(std::uint64_t& num_messages);
+
+    // handles newly received data and prepares the read buffer
+    // for the next read unless this peer migrated
+    continue_reading_result parse_rd_buf(bool& migrated);
+
+    // set if m_in is a plain socket, see completion()
+    bool m_completion_reads;
+
+    // set after the handshake if this peer belongs to another event loop
+    bool m_migrate;
+
+    // parses the frames received before this peer was
+    // moved to its event loop; note: called by default_protocol
+    continue_reading_result resume_reading();
+
+    // returns the size of the next frame in the read buffer
+    size_t bytes_needed() const;
+
+    // moves unparsed bytes to the front of the read buffer
+    // and makes room for the next read
+    void prepare_rd_buf();
+
+    // serialized messages that are not written yet; messages are
+    // appended to the last chunk and all chunks are written at once
+    std::deque<util::buffer> m_wr_chunks;
+
+    // number of bytes already written from the first chunk
+    size_t m_wr_offset;
+
+    // number of bytes in m_wr_chunks that are not written yet
+    size_t m_unwritten_bytes;
+
+    // written chunks, reused for subsequent messages
+    std::vector<util::buffer> m_free_chunks;
+
+    // time the oldest unwritten message was serialized
+    std::chrono::steady_clock::time_point m_wr_since;
+
+    // see default_protocol::flush_policy
+    size_t m_flush_bytes;
+    std::chrono::microseconds m_flush_delay;
+
+    // returns the chunk new messages are appended to
+    util::buffer& wr_buf();
+
+    // writes as many chunks as possible without blocking
+    continue_writing_result flush();
+
+    // bitmasks of default_protocol::wire_feature values used for
+    // received and sent messages; a connection uses the legacy format
+    // until both nodes exchanged FEATURES messages, see negotiate()
+    std::uint32_t m_in_features;
+    std::uint32_t m_out_features;
+
+    // features announced to the remote node (if m_features_sent)
+    std::uint32_t m_offered_features;
+    bool m_features_sent;
+
+    // handles a FEATURES message announcing the features of the remote node
+    void negotiate(std::uint32_t remote_features);
+
+    // per-connection type dictionaries (if enabled)
+    // incoming types are shared with lazily deserialized messages
+    std::shared_ptr<type_lookup_table> m_incoming_types;
+    type_lookup_table m_outgoing_types;
+
+    type_lookup_table* incoming_types();
+
+    type_lookup_table* outgoing_types();
+
+    // return the binary_format_flag bitmask for received and sent messages
+    std::uint32_t incoming_format() const;
+
+    std::uint32_t outgoing_format() const;
 
     default_message_queue_ptr m_queue;
 
@@ -48,6 +48,10 @@ class default_peer_acceptor : public continuable_reader {
 
     continue_reading_result continue_reading();
 
+    completion_mode completion() const;
+
+    continue_reading_result accepted(native_socket_type fd);
+
     default_peer_acceptor(default_protocol* parent,
                           acceptor_uptr ptr,
                           const actor_ptr& published_actor);
@@ -58,6 +62,9 @@ class default_peer_acceptor : public continuable_reader {
 
  private:
 
+    // sends the handshake and hands the connection to the protocol
+    void new_connection(const io_stream_ptr_pair& pair);
+
     default_protocol* m_parent;
     acceptor_uptr m_ptr;
     actor_ptr m_pa;
@@ -32,7 +32,9 @@
 #define DEFAULT_PROTOCOL_HPP
 
 #include <map>
+#include <chrono>
 #include <vector>
+#include <cstdint>
 
 #include "cppa/actor_addressing.hpp"
 #include "cppa/process_information.hpp"
@@ -41,6 +43,7 @@
 #include "cppa/network/default_peer.hpp"
 #include "cppa/network/default_peer_acceptor.hpp"
 #include "cppa/network/default_message_queue.hpp"
+#include "cppa/network/serialized_payload.hpp"
 #include "cppa/network/default_actor_addressing.hpp"
 
 namespace cppa { namespace network {
@@ -51,6 +54,107 @@ class default_protocol : public protocol {
 
  public:
 
+    /**
+     * @brief Optional features of the wire format. Nodes announce a
+     *        bitmask of their supported features in a @p FEATURES message
+     *        after the handshake and a connection uses only features
+     *        supported by both sides. Connections to nodes that do not
+     *        announce any features keep using the legacy format.
+     */
+    enum wire_feature : std::uint32_t {
+        // type names are sent once per connection and replaced
+        // by numeric ids afterwards
+        type_dictionary = 0x01,
+        // floating point values are sent as IEEE 754 values
+        // (binary_format_flag::native_floats)
+        ieee754_floats = 0x02,
+        // integers and sizes are sent as varints
+        // (binary_format_flag::varint_integers)
+        compact_integers = 0x04,
+        // messages that are deserializable without the state of the
+        // connection are flagged and deserialized by their receiver
+        // (see detail::lazy_tuple)
+        lazy_payloads = 0x08
+    };
+
+    /**
+     * @brief The features a node offers unless configured otherwise.
+     */
+    static constexpr std::uint32_t default_features = type_dictionary
+                                                    | ieee754_floats
+                                                    | lazy_payloads;
+
+    /**
+     * @brief Returns a bitmask of all features offered by this node.
+     */
+    static std::uint32_t supported_features();
+
+    /**
+     * @brief Sets the features offered by this node, e.g.,
+     *        <tt>default_features | compact_integers</tt> to opt in
+     *        to varint encoding for connections to nodes that do so too.
+     * @note Affects only connections established afterwards.
+     */
+    static void supported_features(std::uint32_t features);
+
+    /**
+     * @brief Returns the binary_format_flag bitmask for
+     *        connections using @p features.
+     */
+    static std::uint32_t binary_format(std::uint32_t features);
+
+    /**
+     * @brief Byte threshold for writing buffered messages
+     *        (64 KiB unless configured otherwise).
+     */
+    static size_t flush_bytes();
+
+    /**
+     * @brief Latency budget for writing buffered messages
+     *        (1ms unless configured otherwise).
+     */
+    static std::chrono::microseconds flush_delay();
+
+    /**
+     * @brief Configures when peers write buffered messages. A peer
+     *        writes all messages buffered while the middleman handles
+     *        pending events at once, thus sporadic messages are never
+     *        delayed. During bursts, it writes earlier as soon as
+     *        @p max_bytes are buffered or the oldest buffered message
+     *        waited for @p max_delay. A peer buffers at most
+     *        @p max_bytes while its socket is not writable; further
+     *        messages remain in its message queue.
+     * @note Affects only connections established afterwards.
+     */
+    static void flush_policy(size_t max_bytes,
+                             std::chrono::microseconds max_delay);
+
+    /**
+     * @brief I/O counters of all connections of this node.
+     */
+    struct io_statistics {
+        std::uint64_t read_calls;
+        std::uint64_t messages_read;
+        std::uint64_t write_calls;
+        std::uint64_t messages_written;
+        /**
+         * @brief Returns the average number of read syscalls per message.
+         */
+        double reads_per_message() const;
+        /**
+         * @brief Returns the average number of write syscalls per message.
+         */
+        double writes_per_message() const;
+    };
+
+    /**
+     * @brief Returns the I/O counters of all connections of this node.
+     */
+    static io_statistics statistics();
+
+    // note: called by default_peer
+    static void add_statistics(const io_statistics& stats);
+
     default_protocol(abstract_middleman* parent);
 
     atom_value identifier() const;
@@ -67,20 +171,43 @@ class default_protocol : public protocol {
 
     actor_ptr remote_actor(io_stream_ptr_pair ioptrs, variant_args args);
 
+    /**
+     * @brief Returns the index of the event loop handling
+     *        the connection to @p node.
+     */
+    size_t loop_of(const process_information& node) const;
+
+    /**
+     * @brief Returns the number of event loops of the middleman.
+     */
+    inline size_t num_loops() const { return m_peers.size(); }
+
+    // note: the following member functions must be called
+    //       from the event loop of the given node or peer
+
     void register_peer(const process_information& node, default_peer* ptr);
 
     default_peer_ptr get_peer(const process_information& node);
 
+    /**
+     * @param payload @p msg serialized by the sender or @p nullptr.
+     */
     void enqueue(const process_information& node,
                  const message_header& hdr,
-                 any_tuple msg);
+                 any_tuple msg,
+                 serialized_payload_ptr payload = nullptr);
 
     void new_peer(const input_stream_ptr& in,
                   const output_stream_ptr& out,
-                  const process_information_ptr& node = nullptr);
+                  const process_information_ptr& node = nullptr,
+                  std::uint32_t offered_features = 0);
 
     void last_proxy_exited(const default_peer_ptr& pptr);
 
+    // moves an incoming connection to the event loop of its node
+    // after the handshake; note: called by default_peer
+    void migrate(const default_peer_ptr& pptr);
+
     void continue_writer(const default_peer_ptr& pptr);
 
     // covariant return type
@@ -95,7 +222,8 @@ class default_protocol : public protocol {
 
     default_actor_addressing m_addressing;
     std::map<actor_ptr,std::vector<default_peer_acceptor_ptr> > m_acceptors;
-    std::map<process_information,peer_entry> m_peers;
+    // indexed by event loop, see loop_of()
+    std::vector<std::map<process_information,peer_entry> > m_peers;
 
 };
 
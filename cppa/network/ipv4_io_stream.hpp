@@ -56,6 +56,8 @@ class ipv4_io_stream : public io_stream {
 
     size_t write_some(const void* buf, size_t len);
 
+    size_t write_some(const output_slice* slices, size_t num_slices);
+
  private:
 
     ipv4_io_stream(native_socket_type fd);
@@ -36,15 +36,49 @@
 #include <memory>
 #include <functional>
 
+#include "cppa/memory_managed.hpp"
+
 #include "cppa/network/protocol.hpp"
 #include "cppa/network/acceptor.hpp"
 #include "cppa/network/continuable_reader.hpp"
 #include "cppa/network/continuable_io.hpp"
 
+#include "cppa/intrusive/single_reader_queue.hpp"
+
 namespace cppa { namespace detail { class singleton_manager; } }
 
 namespace cppa { namespace network {
 
+/**
+ * @brief A command that is executed in the middleman's event loop.
+ */
+class middleman_event : public memory_managed {
+
+    friend class intrusive::single_reader_queue<middleman_event>;
+
+ public:
+
+    inline middleman_event() : next(nullptr) { }
+
+    virtual ~middleman_event();
+
+    /**
+     * @brief Executes this command.
+     */
+    virtual void run() = 0;
+
+    /**
+     * @brief Releases this command after it was executed. The default
+     *        implementation calls <tt>delete this</tt>.
+     */
+    virtual void dispose();
+
+ private:
+
+    middleman_event* next;
+
+};
+
 /**
  * @brief Multiplexes asynchronous IO.
  */
@@ -67,10 +101,33 @@ class middleman : public ref_counted {
     virtual protocol_ptr protocol(atom_value id) = 0;
 
     /**
-     * @brief Runs @p fun in the middleman's event loop.
+     * @brief Runs @p fun in the middleman's main event loop.
      */
     virtual void run_later(std::function<void()> fun) = 0;
 
+    /**
+     * @brief Runs @p what in the middleman's main event loop and
+     *        disposes it afterwards.
+     */
+    virtual void run_later(middleman_event* what) = 0;
+
+    /**
+     * @brief Runs @p fun in the event loop with index @p loop.
+     */
+    virtual void run_later(size_t loop, std::function<void()> fun) = 0;
+
+    /**
+     * @brief Runs @p what in the event loop with index @p loop
+     *        and disposes it afterwards.
+     */
+    virtual void run_later(size_t loop, middleman_event* what) = 0;
+
+    /**
+     * @brief Returns the number of event loops, each running in its
+     *        own thread. The main event loop has index 0.
+     */
+    virtual size_t num_loops() const = 0;
+
  protected:
 
     virtual void destroy() = 0;
@@ -83,13 +140,21 @@ class middleman : public ref_counted {
 
 };
 
-class middleman_event_handler;
+/**
+ * @brief Sets a middleman running @p num_loops event loops. Each
+ *        connection is handled by the event loop of its remote node,
+ *        while acceptors and other commands run in the main event loop.
+ * @note Must be called before any other network operation.
+ * @throws std::runtime_error if there's already a middleman defined.
+ */
+void set_default_middleman(size_t num_loops);
 
 class abstract_middleman : public middleman {
 
  public:
 
-    inline abstract_middleman() : m_done(false) { }
+    // note: the following member functions operate on the event loop
+    //       returned by ptr->loop_id() and must be called from it
 
     void stop_writer(const continuable_reader_ptr& ptr);
     void continue_writer(const continuable_reader_ptr& ptr);
@@ -97,16 +162,6 @@ class abstract_middleman : public middleman {
     void stop_reader(const continuable_reader_ptr& what);
     void continue_reader(const continuable_reader_ptr& what);
 
- protected:
-
-    inline void quit() { m_done = true; }
-    inline bool done() const { return m_done; }
-
-    bool m_done;
-    std::vector<continuable_reader_ptr> m_readers;
-
-    middleman_event_handler& handler();
-
 };
 
 } } // namespace cppa::detail
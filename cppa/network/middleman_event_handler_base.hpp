@@ -234,7 +234,7 @@ class event_iterator_impl {
     }
 
     inline continue_reading_result continue_reading() {
-        return ptr()->continue_reading();
+        return m_access.continue_reading(m_i);
     }
 
     inline continue_writing_result continue_writing() {
@@ -37,6 +37,14 @@
 
 namespace cppa { namespace network {
 
+/**
+ * @brief A contiguous block of bytes for scatter-gather output.
+ */
+struct output_slice {
+    const void* data;
+    size_t size;
+};
+
 /**
  * @brief An abstract output stream interface.
  */
@@ -65,6 +73,15 @@ class output_stream : public virtual ref_counted {
      */
     virtual size_t write_some(const void* buf, size_t num_bytes) = 0;
 
+    /**
+     * @brief Tries to write the @p num_slices blocks in @p slices
+     *        in order. The default implementation calls
+     *        <tt>write_some</tt> once per slice.
+     * @returns The number of written bytes.
+     * @throws std::ios_base::failure
+     */
+    virtual size_t write_some(const output_slice* slices, size_t num_slices);
+
 };
 
 /**
@@ -47,6 +47,7 @@ namespace cppa { class actor_addressing; }
 
 namespace cppa { namespace network {
 
+class middleman_event;
 class abstract_middleman;
 class continuable_reader;
 class continuable_io;
@@ -83,6 +84,12 @@ class protocol : public ref_counted {
 
     void run_later(std::function<void()> fun);
 
+    void run_later(middleman_event* what);
+
+    void run_later(size_t loop, std::function<void()> fun);
+
+    void run_later(size_t loop, middleman_event* what);
+
     struct ref_ftor {
         void operator()(abstract_middleman*) const;
     };
@@ -0,0 +1,142 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_SERIALIZED_PAYLOAD_HPP
+#define CPPA_SERIALIZED_PAYLOAD_HPP
+
+#include <cstdint>
+
+#include "cppa/any_tuple.hpp"
+#include "cppa/ref_counted.hpp"
+#include "cppa/intrusive_ptr.hpp"
+#include "cppa/actor_addressing.hpp"
+#include "cppa/type_lookup_table.hpp"
+#include "cppa/binary_serializer.hpp"
+
+#include "cppa/util/buffer.hpp"
+
+namespace cppa { namespace network {
+
+/**
+ * @brief A message serialized independently of any connection.
+ *
+ * Type names are stored separately and written per connection,
+ * because each connection has its own type dictionary.
+ */
+class serialized_payload : public ref_counted {
+
+ public:
+
+    /**
+     * @brief Lets {@link from()} share payloads between all calls of
+     *        the current thread until the outermost scope is left.
+     *
+     * Used by loops sending one message to several nodes, e.g., by a
+     * local group. The cache keeps the messages alive only for the
+     * lifetime of this object.
+     */
+    class fan_out_scope {
+
+        fan_out_scope(const fan_out_scope&) = delete;
+        fan_out_scope& operator=(const fan_out_scope&) = delete;
+
+     public:
+
+        fan_out_scope();
+
+        ~fan_out_scope();
+
+    };
+
+    serialized_payload();
+
+    /**
+     * @brief Returns @p msg serialized using @p format.
+     *
+     * Within a {@link fan_out_scope}, a message sent to several nodes
+     * is serialized only once.
+     * @note Thread-safe as long as @p addressing is.
+     */
+    static intrusive_ptr<serialized_payload> from(const any_tuple& msg,
+                                                  actor_addressing* addressing,
+                                                  std::uint32_t format);
+
+    /**
+     * @brief Serializes @p msg using @p format, replacing
+     *        previous content.
+     */
+    void assign(const any_tuple& msg,
+                actor_addressing* addressing,
+                std::uint32_t format);
+
+    /**
+     * @brief Writes the payload to @p sink, producing the same
+     *        output as <tt>sink << msg</tt> if @p sink has the
+     *        format used in {@link assign()}.
+     */
+    void write_to(binary_serializer& sink) const;
+
+    /**
+     * @brief Checks whether the payload can be deserialized without
+     *        an actor addressing and without adding types to @p types,
+     *        i.e., whether a {@link detail::lazy_tuple} can read it.
+     */
+    bool self_contained(const type_lookup_table* types) const;
+
+    void clear();
+
+    inline size_t size() const { return m_data.size(); }
+
+    /**
+     * @brief Returns the format used in {@link assign()}.
+     */
+    inline std::uint32_t format() const { return m_format; }
+
+ protected:
+
+    /**
+     * @brief Recycles this payload for a later call to
+     *        {@link from()} instead of deleting it.
+     */
+    void request_deletion();
+
+ private:
+
+    std::uint32_t m_format;
+    util::buffer m_data;
+    binary_serializer::type_name_list m_type_names;
+
+};
+
+typedef intrusive_ptr<serialized_payload> serialized_payload_ptr;
+
+} } // namespace cppa::network
+
+#endif // CPPA_SERIALIZED_PAYLOAD_HPP
@@ -33,6 +33,7 @@
 
 #include <chrono>
 #include <memory>
+#include <vector>
 #include <cstdint>
 #include <functional>
 
@@ -184,6 +185,13 @@ class scheduler {
                             init_callback init_cb,
                             scheduling_hint hint = scheduled) = 0;
 
+    /**
+     * @brief Spawns all event-based actors in @p what at once.
+     * @returns An {@link actor_ptr} for each element in @p what.
+     */
+    virtual std::vector<actor_ptr> spawn_n(std::vector<scheduled_actor*> what,
+                                           scheduling_hint hint = scheduled);
+
     // hide implementation details for documentation
 #   ifndef CPPA_DOCUMENTATION
 
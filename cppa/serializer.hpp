@@ -34,6 +34,7 @@
 #include <string>
 #include <cstddef> // size_t
 
+#include "cppa/primitive_type.hpp"
 #include "cppa/uniform_type_info.hpp"
 #include "cppa/detail/to_uniform_name.hpp"
 
@@ -99,6 +100,20 @@ class serializer {
      */
     virtual void write_tuple(size_t num, const primitive_variant* values) = 0;
 
+    /**
+     * @brief Writes @p num values of type @p ptype stored
+     *        in the contiguous array @p values.
+     *
+     * The default implementation calls {@link write_value()}
+     * for each element.
+     * @param ptype Type of the elements in @p values.
+     * @param num Size of the array @p values.
+     * @param values An array of size @p num.
+     */
+    virtual void write_array(primitive_type ptype,
+                             size_t num,
+                             const void* values);
+
     inline actor_addressing* addressing() { return m_addressing; }
 
  private:
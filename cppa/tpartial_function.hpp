@@ -87,6 +87,10 @@ class tpartial_function {
                ::_(m_expr, args...);
     }
 
+    inline const Guard& guard() const {
+        return m_guard;
+    }
+
  private:
 
     Guard m_guard;
@@ -0,0 +1,106 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_TYPE_LOOKUP_TABLE_HPP
+#define CPPA_TYPE_LOOKUP_TABLE_HPP
+
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+#include "cppa/util/shared_spinlock.hpp"
+
+namespace cppa {
+
+/**
+ * @brief Maps uniform type names to small integers for one direction
+ *        of a connection, i.e., each type name is transmitted only once.
+ *
+ * Ids are assigned in ascending order starting at 1. Both sides of
+ * a connection assign the same ids as long as all names are
+ * read in the order they were written.
+ *
+ * {@link name_of()} can be called concurrently to {@link append()},
+ * e.g., to deserialize a message while the connection adds new types.
+ * All other member functions require exclusive access.
+ */
+class type_lookup_table {
+
+ public:
+
+    /**
+     * @brief Returns the id of @p tname and @p true if @p tname was
+     *        added to the table, i.e., if it has to be sent along with the id.
+     */
+    std::pair<std::uint32_t, bool> add(const std::string& tname);
+
+    /**
+     * @brief Adds @p tname with the next free id.
+     */
+    void append(std::string tname);
+
+    /**
+     * @brief Returns the name of the type with id @p id
+     *        or @p nullptr if @p id is unknown.
+     * @note The result remains valid until the name is
+     *       removed by {@link truncate()}.
+     */
+    const std::string* name_of(std::uint32_t id) const;
+
+    /**
+     * @brief Checks whether @p tname has an id.
+     */
+    bool contains(const std::string& tname) const;
+
+    /**
+     * @brief Returns the number of types in this table.
+     */
+    inline size_t size() const { return m_names.size(); }
+
+    /**
+     * @brief Removes all types added after the table had @p new_size entries.
+     */
+    void truncate(size_t new_size);
+
+ private:
+
+    // a deque never moves its elements on append
+    std::deque<std::string> m_names;
+    mutable util::shared_spinlock m_names_mtx;
+    std::unordered_map<std::string, std::uint32_t> m_ids;
+
+};
+
+} // namespace cppa
+
+#endif // CPPA_TYPE_LOOKUP_TABLE_HPP
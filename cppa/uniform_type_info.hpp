@@ -46,6 +46,8 @@
 #include "cppa/detail/demangle.hpp"
 #include "cppa/detail/to_uniform_name.hpp"
 
+namespace cppa { namespace detail { class uniform_type_info_map; } }
+
 namespace cppa {
 
 class serializer;
@@ -149,6 +151,8 @@ class uniform_type_info {
 
     friend class object;
 
+    friend class detail::uniform_type_info_map;
+
     friend bool operator==(const uniform_type_info& lhs,
                            const uniform_type_info& rhs);
 
@@ -180,6 +184,14 @@ class uniform_type_info {
      */
     static const uniform_type_info* from(const std::type_info& tinfo);
 
+    /**
+     * @brief Get instance by type id.
+     * @param type_id A type id as returned by {@link type_id()}.
+     * @returns The instance associated to @p type_id.
+     * @throws std::runtime_error if no type with id @p type_id was found.
+     */
+    static const uniform_type_info* from_id(std::uint32_t type_id);
+
     /**
      * @brief Get all instances.
      * @returns A vector with all known (announced) instances.
@@ -192,6 +204,12 @@ class uniform_type_info {
      */
     inline const std::string& name() const { return m_name; }
 
+    /**
+     * @brief Get the small integer that identifies this type
+     *        in this process (assigned when the type is announced).
+     */
+    inline std::uint32_t type_id() const { return m_id; }
+
     /**
      * @brief Creates an object of this type.
      */
@@ -274,6 +292,8 @@ class uniform_type_info {
 
     std::string m_name;
 
+    std::uint32_t m_id;
+
 };
 
 /**
@@ -0,0 +1,116 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_BLOB_HPP
+#define CPPA_BLOB_HPP
+
+#include <cstddef>
+
+#include "cppa/ref_counted.hpp"
+#include "cppa/intrusive_ptr.hpp"
+
+namespace cppa { namespace util {
+
+/**
+ * @brief An immutable, reference counted sequence of bytes.
+ *
+ * Copies of a blob share the same data. A blob can refer to a part of
+ * a larger memory region, e.g., a received network frame, which is kept
+ * alive as long as at least one blob refers to it.
+ */
+class blob {
+
+ public:
+
+    typedef const char* const_iterator;
+
+    /**
+     * @brief Creates an empty blob.
+     */
+    blob();
+
+    /**
+     * @brief Creates a blob from a copy of @p num_bytes bytes of @p data.
+     */
+    blob(const void* data, size_t num_bytes);
+
+    /**
+     * @brief Creates a blob referring to @p num_bytes bytes of @p data
+     *        without copying them.
+     * @pre @p owner keeps @p data alive and does not modify it.
+     */
+    blob(intrusive_ptr<ref_counted> owner, const char* data, size_t num_bytes);
+
+    inline const char* data() const { return m_data; }
+
+    inline size_t size() const { return m_size; }
+
+    inline bool empty() const { return m_size == 0; }
+
+    inline const_iterator begin() const { return m_data; }
+
+    inline const_iterator end() const { return m_data + m_size; }
+
+    /**
+     * @brief Returns the object that keeps the data of this blob alive.
+     */
+    inline const intrusive_ptr<ref_counted>& owner() const { return m_owner; }
+
+    /**
+     * @brief Returns a blob referring to @p num_bytes bytes of this blob,
+     *        starting at @p offset, without copying them.
+     * @throws std::out_of_range if the range exceeds this blob
+     */
+    blob slice(size_t offset, size_t num_bytes) const;
+
+ private:
+
+    intrusive_ptr<ref_counted> m_owner;
+    const char* m_data;
+    size_t m_size;
+
+};
+
+/**
+ * @brief Compares the content of @p lhs and @p rhs.
+ * @relates blob
+ */
+bool operator==(const blob& lhs, const blob& rhs);
+
+/**
+ * @relates blob
+ */
+inline bool operator!=(const blob& lhs, const blob& rhs) {
+    return !(lhs == rhs);
+}
+
+} } // namespace cppa::util
+
+#endif // CPPA_BLOB_HPP
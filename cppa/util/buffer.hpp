@@ -123,6 +123,14 @@ class buffer {
      */
     void append_from(network::input_stream* istream);
 
+    /**
+     * @brief Adds @p num_bytes that were written to <tt>data() + size()</tt>
+     *        by other means, e.g., by the kernel, to the buffer.
+     */
+    inline void appended(size_t num_bytes) {
+        inc_size(num_bytes);
+    }
+
  private:
 
     // pointer to the current write position
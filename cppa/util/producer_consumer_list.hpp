@@ -31,7 +31,7 @@
 #ifndef CPPA_PRODUCER_CONSUMER_LIST_HPP
 #define CPPA_PRODUCER_CONSUMER_LIST_HPP
 
-#define CPPA_CACHE_LINE_SIZE 64
+#include "cppa/config.hpp"
 
 #include <chrono>
 #include <thread>
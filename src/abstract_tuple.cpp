@@ -47,6 +47,10 @@ const std::type_info* abstract_tuple::type_token() const {
     return &typeid(void);
 }
 
+const void* abstract_tuple::signature_token() const {
+    return nullptr;
+}
+
 const void* abstract_tuple::native_data() const {
     return nullptr;
 }
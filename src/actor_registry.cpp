@@ -28,8 +28,10 @@
 \******************************************************************************/
 
 
+#include <array>
 #include <mutex>
 #include <limits>
+#include <utility>
 #include <stdexcept>
 
 #include "cppa/logging.hpp"
@@ -45,34 +47,57 @@ typedef std::lock_guard<cppa::util::shared_spinlock> exclusive_guard;
 typedef cppa::util::shared_lock_guard<cppa::util::shared_spinlock> shared_guard;
 typedef cppa::util::upgrade_lock_guard<cppa::util::shared_spinlock> upgrade_guard;
 
+// each thread reserves IDs in blocks to avoid contention on m_ids
+constexpr std::uint32_t s_id_block_size = 64;
+
+// next free ID and end of the ID block of the calling thread
+__thread std::uint32_t t_next_id = 0;
+__thread std::uint32_t t_id_block_end = 0;
+
+// index + 1 of the running-actors-count shard of the calling thread
+__thread size_t t_running_shard = 0;
+
+std::atomic<size_t> s_next_running_shard;
+
 } // namespace <anonymous>
 
 namespace cppa { namespace detail {
 
-actor_registry::actor_registry() : m_running(0), m_ids(1) {
+actor_registry::actor_registry()
+: m_awaiting(0), m_ids(1)
+, m_retention(std::chrono::duration_cast<clock_type::duration>(
+                  std::chrono::seconds(60)).count()) {
 }
 
 actor_registry::value_type actor_registry::get_entry(actor_id key) const {
-    shared_guard guard(m_instances_mtx);
-    auto i = m_entries.find(key);
-    if (i != m_entries.end()) {
-        return i->second;
+    auto& shard = shard_of(key);
+    { // lifetime scope of guard
+        shared_guard guard(shard.mtx);
+        auto i = shard.entries.find(key);
+        if (i != shard.entries.end()) {
+            return i->second;
+        }
     }
     CPPA_LOG_DEBUG("no cache entry found for " << CPPA_ARG(key));
+    // actors are put into the registry before any other node can learn
+    // their ID, i.e., an ID that was already handed out but has no
+    // entry belongs to an actor whose tombstone was reclaimed
+    if (key < m_ids.load()) return {nullptr, exit_reason::unknown};
     return {nullptr, exit_reason::not_exited};
 }
 
 void actor_registry::put(actor_id key, const actor_ptr& value) {
     bool add_attachable = false;
     if (value != nullptr) {
-        shared_guard guard(m_instances_mtx);
-        auto i = m_entries.find(key);
-        if (i == m_entries.end()) {
+        auto& shard = shard_of(key);
+        shared_guard guard(shard.mtx);
+        auto i = shard.entries.find(key);
+        if (i == shard.entries.end()) {
             auto entry = std::make_pair(key,
                                         value_type(value,
                                                    exit_reason::not_exited));
             upgrade_guard uguard(guard);
-            add_attachable = m_entries.insert(entry).second;
+            add_attachable = shard.entries.insert(entry).second;
         }
     }
     if (add_attachable) {
@@ -93,35 +118,87 @@ void actor_registry::put(actor_id key, const actor_ptr& value) {
 }
 
 void actor_registry::erase(actor_id key, std::uint32_t reason) {
-    exclusive_guard guard(m_instances_mtx);
-    auto i = m_entries.find(key);
-    if (i != m_entries.end()) {
+    auto now = clock_type::now();
+    auto& shard = shard_of(key);
+    exclusive_guard guard(shard.mtx);
+    auto i = shard.entries.find(key);
+    if (i != shard.entries.end()) {
         auto& entry = i->second;
         CPPA_LOG_INFO("erased " << key << ", reason = " << std::hex << reason);
         entry.first = nullptr;
         entry.second = reason;
+        clock_type::duration retention{m_retention.load()};
+        shard.tombstones.emplace_back(now + retention, key);
+    }
+    reclaim_tombstones(shard, now);
+}
+
+void actor_registry::tombstone_retention(std::chrono::milliseconds value) {
+    auto d = std::chrono::duration_cast<clock_type::duration>(value);
+    m_retention = d.count();
+}
+
+void actor_registry::reclaim_tombstones(entries_shard& shard,
+                                        clock_type::time_point now) {
+    auto& tombstones = shard.tombstones;
+    while (!tombstones.empty() && tombstones.front().first <= now) {
+        auto i = shard.entries.find(tombstones.front().second);
+        if (i != shard.entries.end() && i->second.first == nullptr) {
+            shard.entries.erase(i);
+        }
+        tombstones.pop_front();
     }
 }
 
 std::uint32_t actor_registry::next_id() {
-    return m_ids.fetch_add(1);
+    if (t_next_id == t_id_block_end) {
+        t_next_id = m_ids.fetch_add(s_id_block_size);
+        t_id_block_end = t_next_id + s_id_block_size;
+    }
+    return t_next_id++;
+}
+
+auto actor_registry::local_running_shard() -> running_shard& {
+    if (t_running_shard == 0) {
+        t_running_shard = (s_next_running_shard++ % num_running_shards) + 1;
+    }
+    return m_running[t_running_shard - 1];
 }
 
-void actor_registry::inc_running() {
-    ++m_running;
+void actor_registry::inc_running(size_t num) {
+    local_running_shard().started += num;
 }
 
 size_t actor_registry::running() const {
-    return m_running.load();
+    // both counters of a shard grow monotonically, hence two
+    // equal collects denote a consistent snapshot of all shards
+    typedef std::array<std::uint64_t, num_running_shards * 2> collect_type;
+    auto collect = [&](collect_type& storage) {
+        for (size_t i = 0; i < num_running_shards; ++i) {
+            storage[i * 2] = m_running[i].started.load();
+            storage[i * 2 + 1] = m_running[i].finished.load();
+        }
+    };
+    collect_type c0;
+    collect_type c1;
+    collect(c0);
+    for (;;) {
+        collect(c1);
+        if (c0 == c1) {
+            std::uint64_t result = 0;
+            for (size_t i = 0; i < num_running_shards; ++i) {
+                result += c1[i * 2] - c1[i * 2 + 1];
+            }
+            return static_cast<size_t>(result);
+        }
+        std::swap(c0, c1);
+    }
 }
 
 void actor_registry::dec_running() {
-    size_t new_val = --m_running;
-    /*
-    if (new_val == std::numeric_limits<size_t>::max()) {
-        throw std::underflow_error("actor_count::dec()");
-    }
-    else*/ if (new_val <= 1) {
+    ++(local_running_shard().finished);
+    // only aggregate the shards if someone actually waits for the count
+    if (m_awaiting.load() > 0 && running() <= 1) {
         std::unique_lock<std::mutex> guard(m_running_mtx);
         m_running_cv.notify_all();
     }
@@ -129,10 +206,14 @@ void actor_registry::dec_running() {
 
 void actor_registry::await_running_count_equal(size_t expected) {
     CPPA_LOG_TRACE(CPPA_ARG(expected));
-    std::unique_lock<std::mutex> guard(m_running_mtx);
-    while (m_running.load() != expected) {
-        m_running_cv.wait(guard);
+    ++m_awaiting;
+    { // lifetime scope of guard
+        std::unique_lock<std::mutex> guard(m_running_mtx);
+        while (running() != expected) {
+            m_running_cv.wait(guard);
+        }
     }
+    --m_awaiting;
 }
 
 } } // namespace cppa::detail
@@ -28,6 +28,7 @@
 \******************************************************************************/
 
 
+#include <limits>
 #include <string>
 #include <cstdint>
 #include <cstring>
@@ -38,9 +39,13 @@
 #include <stdexcept>
 #include <type_traits>
 
+#include "cppa/config.hpp"
 #include "cppa/logging.hpp"
+#include "cppa/type_lookup_table.hpp"
 #include "cppa/binary_deserializer.hpp"
 
+#include "cppa/detail/swap_bytes.hpp"
+
 using namespace std;
 
 namespace cppa {
@@ -64,21 +69,64 @@ iterator read_range(iterator begin, iterator end, T& storage,
     return begin + sizeof(T);
 }
 
-iterator read_range(iterator begin, iterator end, string& storage) {
+template<typename T>
+iterator read_varint(iterator begin, iterator end, T& storage) {
+    storage = 0;
+    for (size_t shift = 0; shift < sizeof(T) * 8; shift += 7) {
+        range_check(begin, end, 1);
+        auto byte = static_cast<uint8_t>(*begin++);
+        storage |= static_cast<T>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return begin;
+    }
+    throw logic_error("binary_deserializer::read_varint(): malformed varint");
+}
+
+// reverts the zigzag encoding of signed integers
+template<typename T>
+inline T unzigzag(uint64_t value, true_type) {
+    return static_cast<T>(static_cast<int64_t>(value >> 1)
+                          ^ -static_cast<int64_t>(value & 1));
+}
+
+template<typename T>
+inline T unzigzag(uint64_t value, false_type) {
+    return static_cast<T>(value);
+}
+
+template<typename T>
+iterator read_range(iterator begin, iterator end, T& storage, uint32_t format,
+                    typename enable_if<is_integral<T>::value>::type* = 0) {
+    if (sizeof(T) > 1 && (format & varint_integers)) {
+        uint64_t tmp;
+        begin = read_varint(begin, end, tmp);
+        integral_constant<bool, is_signed<T>::value> token;
+        storage = unzigzag<T>(tmp, token);
+        return begin;
+    }
+    return read_range(begin, end, storage);
+}
+
+// reads sizes of sequences and strings
+iterator read_length(iterator begin, iterator end, uint32_t& storage,
+                     uint32_t format) {
+    return (format & varint_integers) ? read_varint(begin, end, storage)
+                                      : read_range(begin, end, storage);
+}
+
+iterator read_range(iterator begin, iterator end, string& storage,
+                    uint32_t format) {
     uint32_t str_size;
-    begin = read_range(begin, end, str_size);
+    begin = read_length(begin, end, str_size, format);
     range_check(begin, end, str_size);
-    storage.clear();
-    storage.reserve(str_size);
-    iterator cpy_end = begin + str_size;
-    copy(begin, cpy_end, back_inserter(storage));
+    storage.assign(begin, str_size);
     return begin + str_size;
 }
 
 template<typename CharType, typename StringType>
-iterator read_unicode_string(iterator begin, iterator end, StringType& str) {
+iterator read_unicode_string(iterator begin, iterator end, StringType& str,
+                             uint32_t format) {
     uint32_t str_size;
-    begin = read_range(begin, end, str_size);
+    begin = read_length(begin, end, str_size, format);
     str.reserve(str_size);
     for (size_t i = 0; i < str_size; ++i) {
         CharType c;
@@ -90,38 +138,113 @@ iterator read_unicode_string(iterator begin, iterator end, StringType& str) {
 
 // @returns the next iterator position
 template<typename T>
-iterator read_range(iterator begin, iterator end, T& value,
-              typename enable_if<is_floating_point<T>::value>::type* = 0) {
+iterator read_decimal(iterator begin, iterator end, T& value,
+                      uint32_t format) {
     // floating points are written as strings
     string str;
-    auto result = read_unicode_string<char>(begin, end, str);
+    auto result = read_unicode_string<char>(begin, end, str, format);
     istringstream iss(str);
     iss >> value;
     return result;
 }
 
-iterator read_range(iterator begin, iterator end, u16string& storage) {
+// reads the bit pattern of an IEEE 754 value in little endian
+template<typename Int, typename Float>
+iterator read_ieee754(iterator begin, iterator end, Float& value) {
+    static_assert(sizeof(Int) == sizeof(Float), "sizeof(Int) != sizeof(Float)");
+    Int bits;
+    begin = read_range(begin, end, bits);
+#   ifdef CPPA_BIG_ENDIAN
+    bits = detail::swap_bytes(bits);
+#   endif
+    memcpy(&value, &bits, sizeof(Float));
+    return begin;
+}
+
+iterator read_range(iterator begin, iterator end, float& value,
+                    uint32_t format) {
+    return (format & native_floats) ? read_ieee754<uint32_t>(begin, end, value)
+                                    : read_decimal(begin, end, value, format);
+}
+
+iterator read_range(iterator begin, iterator end, double& value,
+                    uint32_t format) {
+    return (format & native_floats) ? read_ieee754<uint64_t>(begin, end, value)
+                                    : read_decimal(begin, end, value, format);
+}
+
+iterator read_range(iterator begin, iterator end, long double& value,
+                    uint32_t format) {
+    // long double is always written in its decimal representation
+    return read_decimal(begin, end, value, format);
+}
+
+iterator read_range(iterator begin, iterator end, u16string& storage,
+                    uint32_t format) {
     // char16_t is guaranteed to has *at least* 16 bytes,
     // but not to have *exactly* 16 bytes; thus use uint16_t
-    return read_unicode_string<uint16_t>(begin, end, storage);
+    return read_unicode_string<uint16_t>(begin, end, storage, format);
 }
 
-iterator read_range(iterator begin, iterator end, u32string& storage) {
+iterator read_range(iterator begin, iterator end, u32string& storage,
+                    uint32_t format) {
     // char32_t is guaranteed to has *at least* 32 bytes,
     // but not to have *exactly* 32 bytes; thus use uint32_t
-    return read_unicode_string<uint32_t>(begin, end, storage);
+    return read_unicode_string<uint32_t>(begin, end, storage, format);
+}
+
+// reads an array written as a single block
+template<typename T>
+iterator read_block(iterator begin, iterator end,
+                    size_t num, void* storage) {
+    if (num > numeric_limits<size_t>::max() / sizeof(T)) {
+        throw out_of_range("binary_deserializer::read_array()");
+    }
+    range_check(begin, end, num * sizeof(T));
+    memcpy(storage, begin, num * sizeof(T));
+    return begin + num * sizeof(T);
+}
+
+// reads an array of IEEE 754 values written as a single block in little endian
+template<typename Int, typename Float>
+iterator read_ieee754_array(iterator begin, iterator end,
+                            size_t num, void* storage) {
+    static_assert(sizeof(Int) == sizeof(Float), "sizeof(Int) != sizeof(Float)");
+    auto result = read_block<Int>(begin, end, num, storage);
+#   ifdef CPPA_BIG_ENDIAN
+    auto i = reinterpret_cast<Int*>(storage);
+    for (auto e = i + num; i != e; ++i) *i = detail::swap_bytes(*i);
+#   endif
+    return result;
+}
+
+// reads an array of integers written as a single block in host byte order
+// unless varints are enabled
+template<typename T>
+iterator read_int_array(iterator begin, iterator end,
+                        size_t num, void* storage, uint32_t format) {
+    if (sizeof(T) > 1 && (format & varint_integers)) {
+        auto i = reinterpret_cast<T*>(storage);
+        for (auto e = i + num; i != e; ++i) {
+            begin = read_range(begin, end, *i, format);
+        }
+        return begin;
+    }
+    return read_block<T>(begin, end, num, storage);
 }
 
 struct pt_reader {
 
     iterator begin;
     iterator end;
+    uint32_t format;
 
-    pt_reader(iterator bbegin, iterator bend) : begin(bbegin), end(bend) { }
+    pt_reader(iterator bbegin, iterator bend, uint32_t fmt)
+    : begin(bbegin), end(bend), format(fmt) { }
 
     template<typename T>
     inline void operator()(T& value) {
-        begin = read_range(begin, end, value);
+        begin = read_range(begin, end, value, format);
     }
 
 };
@@ -129,23 +252,52 @@ struct pt_reader {
 } // namespace <anonmyous>
 
 binary_deserializer::binary_deserializer(const char* buf, size_t buf_size,
-                                         actor_addressing* addressing)
-: super(addressing), pos(buf), end(buf + buf_size) { }
+                                         actor_addressing* addressing,
+                                         type_lookup_table* incoming_types)
+: super(addressing), pos(buf), end(buf + buf_size)
+, m_incoming_types(incoming_types), m_format(default_binary_format) { }
 
 binary_deserializer::binary_deserializer(const char* bbegin, const char* bend,
-                                         actor_addressing* addressing)
-: super(addressing), pos(bbegin), end(bend) { }
+                                         actor_addressing* addressing,
+                                         type_lookup_table* incoming_types)
+: super(addressing), pos(bbegin), end(bend)
+, m_incoming_types(incoming_types), m_format(default_binary_format) { }
+
+const char* binary_deserializer::read_type_name(const char* first,
+                                                const string*& result,
+                                                bool add_to_types) {
+    if (m_incoming_types == nullptr) {
+        result = &m_type_name;
+        return read_range(first, end, m_type_name, m_format);
+    }
+    uint32_t id;
+    first = read_varint(first, end, id);
+    if (id == 0) {
+        // a new type name follows
+        result = &m_type_name;
+        first = read_range(first, end, m_type_name, m_format);
+        if (add_to_types) m_incoming_types->append(m_type_name);
+        return first;
+    }
+    // refer to the table rather than copying the name
+    result = m_incoming_types->name_of(id);
+    if (result == nullptr) {
+        throw logic_error("binary_deserializer: unknown type id "
+                          + std::to_string(id));
+    }
+    return first;
+}
 
-string binary_deserializer::seek_object() {
-    string result;
-    pos = read_range(pos, end, result);
-    return result;
+const string& binary_deserializer::seek_object() {
+    const string* result;
+    pos = read_type_name(pos, result, true);
+    return *result;
 }
 
-string binary_deserializer::peek_object() {
-    string result;
-    read_range(pos, end, result);
-    return result;
+const string& binary_deserializer::peek_object() {
+    const string* result;
+    read_type_name(pos, result, false);
+    return *result;
 }
 
 void binary_deserializer::begin_object(const string&) { }
@@ -157,7 +309,7 @@ size_t binary_deserializer::begin_sequence() {
     static_assert(sizeof(size_t) >= sizeof(uint32_t),
                   "sizeof(size_t) < sizeof(uint32_t)");
     uint32_t result;
-    pos = read_range(pos, end, result);
+    pos = read_length(pos, end, result, m_format);
     return static_cast<size_t>(result);
 }
 
@@ -165,7 +317,7 @@ void binary_deserializer::end_sequence() { }
 
 primitive_variant binary_deserializer::read_value(primitive_type ptype) {
     primitive_variant val(ptype);
-    pt_reader ptr(pos, end);
+    pt_reader ptr(pos, end, m_format);
     val.apply(ptr);
     pos = ptr.begin;
     return val;
@@ -180,10 +332,68 @@ void binary_deserializer::read_tuple(size_t size,
     }
 }
 
+template<typename T>
+void binary_deserializer::read(T& storage) {
+    pos = read_range(pos, end, storage, m_format);
+}
+
+template void binary_deserializer::read(int8_t&);
+template void binary_deserializer::read(int16_t&);
+template void binary_deserializer::read(int32_t&);
+template void binary_deserializer::read(int64_t&);
+template void binary_deserializer::read(uint8_t&);
+template void binary_deserializer::read(uint16_t&);
+template void binary_deserializer::read(uint32_t&);
+template void binary_deserializer::read(uint64_t&);
+template void binary_deserializer::read(float&);
+template void binary_deserializer::read(double&);
+template void binary_deserializer::read(long double&);
+template void binary_deserializer::read(string&);
+template void binary_deserializer::read(u16string&);
+template void binary_deserializer::read(u32string&);
+
 void binary_deserializer::read_raw(size_t num_bytes, void* storage) {
     range_check(pos, end, num_bytes);
     memcpy(storage, pos, num_bytes);
     pos += num_bytes;
 }
 
+util::blob binary_deserializer::read_blob(size_t num_bytes) {
+    range_check(pos, end, num_bytes);
+    util::blob result = m_owner ? util::blob(m_owner, pos, num_bytes)
+                                : util::blob(pos, num_bytes);
+    pos += num_bytes;
+    return result;
+}
+
+void binary_deserializer::read_array(primitive_type ptype,
+                                     size_t num,
+                                     void* storage) {
+    auto fmt = m_format;
+    switch (ptype) {
+     case pt_int8:   pos = read_int_array<int8_t>(pos, end, num, storage, fmt);   break;
+     case pt_int16:  pos = read_int_array<int16_t>(pos, end, num, storage, fmt);  break;
+     case pt_int32:  pos = read_int_array<int32_t>(pos, end, num, storage, fmt);  break;
+     case pt_int64:  pos = read_int_array<int64_t>(pos, end, num, storage, fmt);  break;
+     case pt_uint8:  pos = read_int_array<uint8_t>(pos, end, num, storage, fmt);  break;
+     case pt_uint16: pos = read_int_array<uint16_t>(pos, end, num, storage, fmt); break;
+     case pt_uint32: pos = read_int_array<uint32_t>(pos, end, num, storage, fmt); break;
+     case pt_uint64: pos = read_int_array<uint64_t>(pos, end, num, storage, fmt); break;
+     case pt_float:
+        if (m_format & native_floats) {
+            pos = read_ieee754_array<uint32_t, float>(pos, end, num, storage);
+        }
+        else super::read_array(ptype, num, storage);
+        break;
+     case pt_double:
+        if (m_format & native_floats) {
+            pos = read_ieee754_array<uint64_t, double>(pos, end, num, storage);
+        }
+        else super::read_array(ptype, num, storage);
+        break;
+     default:
+        super::read_array(ptype, num, storage);
+    }
+}
+
 } // namespace cppa
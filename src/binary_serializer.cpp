@@ -35,9 +35,13 @@
 #include <cstring>
 #include <type_traits>
 
+#include "cppa/config.hpp"
 #include "cppa/primitive_variant.hpp"
+#include "cppa/type_lookup_table.hpp"
 #include "cppa/binary_serializer.hpp"
 
+#include "cppa/detail/swap_bytes.hpp"
+
 using std::enable_if;
 
 namespace cppa {
@@ -53,28 +57,109 @@ class binary_writer {
 
  public:
 
-    binary_writer(util::buffer* sink) : m_sink(sink) { }
+    binary_writer(util::buffer* sink, std::uint32_t format)
+    : m_sink(sink), m_format(format) { }
 
     template<typename T>
     static inline void write_int(util::buffer* sink, const T& value) {
         sink->write(sizeof(T), &value, grow_if_needed);
     }
 
-    static inline void write_string(util::buffer* sink,
-                                    const std::string& str) {
-        write_int(sink, static_cast<std::uint32_t>(str.size()));
-        sink->write(str.size(), str.c_str(), grow_if_needed);
+    // writes 7 bits per byte, the highest bit signalizes a following byte
+    static inline void write_varint(util::buffer* sink, std::uint64_t value) {
+        std::uint8_t buf[10];
+        size_t i = 0;
+        while (value > 0x7F) {
+            buf[i++] = static_cast<std::uint8_t>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        buf[i++] = static_cast<std::uint8_t>(value);
+        sink->write(i, buf, grow_if_needed);
+    }
+
+    // maps signed values to unsigned values with small absolute
+    // values mapped to small numbers, i.e., 0, -1, 1, -2, 2, ...
+    template<typename T>
+    static inline std::uint64_t zigzag(T value, std::true_type) {
+        auto x = static_cast<std::int64_t>(value);
+        return (static_cast<std::uint64_t>(x) << 1)
+               ^ static_cast<std::uint64_t>(x >> 63);
+    }
+
+    template<typename T>
+    static inline std::uint64_t zigzag(T value, std::false_type) {
+        return static_cast<std::uint64_t>(value);
+    }
+
+    // writes sizes of sequences and strings
+    void write_length(size_t value) {
+        if (m_format & varint_integers) {
+            write_varint(m_sink, static_cast<std::uint32_t>(value));
+        }
+        else write_int(m_sink, static_cast<std::uint32_t>(value));
     }
 
     template<typename T>
     void operator()(const T& value,
                     typename enable_if<std::is_integral<T>::value>::type* = 0) {
-        write_int(m_sink, value);
+        // a varint cannot shrink single bytes
+        if (sizeof(T) > 1 && (m_format & varint_integers)) {
+            std::integral_constant<bool, std::is_signed<T>::value> token;
+            write_varint(m_sink, zigzag(value, token));
+        }
+        else write_int(m_sink, value);
     }
 
+    // writes an array of integers as a single block in host byte order
+    // unless varints are enabled
     template<typename T>
-    void operator()(const T& value,
-                    typename enable_if<std::is_floating_point<T>::value>::type* = 0) {
+    void write_int_array(size_t num, const void* values) {
+        if (sizeof(T) > 1 && (m_format & varint_integers)) {
+            auto i = reinterpret_cast<const T*>(values);
+            for (auto e = i + num; i != e; ++i) (*this)(*i);
+        }
+        else m_sink->write(num * sizeof(T), values, grow_if_needed);
+    }
+
+    // writes the bit pattern of an IEEE 754 value in little endian
+    template<typename Int, typename Float>
+    static inline void write_ieee754(util::buffer* sink, Float value) {
+        static_assert(sizeof(Int) == sizeof(Float), "sizeof(Int) != sizeof(Float)");
+        static_assert(std::numeric_limits<Float>::is_iec559,
+                      "Float is not an IEEE 754 type");
+        Int bits;
+        memcpy(&bits, &value, sizeof(Float));
+#       ifdef CPPA_BIG_ENDIAN
+        bits = detail::swap_bytes(bits);
+#       endif
+        write_int(sink, bits);
+    }
+
+    // writes an array of IEEE 754 values as a single block in little endian
+    template<typename Int, typename Float>
+    static inline void write_ieee754_array(util::buffer* sink, size_t num,
+                                           const void* values) {
+        static_assert(sizeof(Int) == sizeof(Float), "sizeof(Int) != sizeof(Float)");
+        static_assert(std::numeric_limits<Float>::is_iec559,
+                      "Float is not an IEEE 754 type");
+#       ifdef CPPA_BIG_ENDIAN
+        auto offset = sink->size();
+        sink->write(num * sizeof(Float), values, grow_if_needed);
+        // swap in place; the block in the buffer might be unaligned
+        auto i = sink->data() + offset;
+        for (auto e = i + num * sizeof(Int); i != e; i += sizeof(Int)) {
+            Int bits;
+            memcpy(&bits, i, sizeof(Int));
+            bits = detail::swap_bytes(bits);
+            memcpy(i, &bits, sizeof(Int));
+        }
+#       else
+        sink->write(num * sizeof(Float), values, grow_if_needed);
+#       endif
+    }
+
+    template<typename T>
+    void write_decimal(const T& value) {
         // write floating points as strings
         std::ostringstream iss;
         iss.precision(std::numeric_limits<T>::max_digits10);
@@ -82,12 +167,33 @@ class binary_writer {
         (*this)(iss.str());
     }
 
+    void operator()(float value) {
+        if (m_format & native_floats) {
+            write_ieee754<std::uint32_t>(m_sink, value);
+        }
+        else write_decimal(value);
+    }
+
+    void operator()(double value) {
+        if (m_format & native_floats) {
+            write_ieee754<std::uint64_t>(m_sink, value);
+        }
+        else write_decimal(value);
+    }
+
+    void operator()(long double value) {
+        // the size and representation of long double is platform
+        // dependent; always use the (portable) decimal representation
+        write_decimal(value);
+    }
+
     void operator()(const std::string& str) {
-        write_string(m_sink, str);
+        write_length(str.size());
+        m_sink->write(str.size(), str.c_str(), grow_if_needed);
     }
 
     void operator()(const std::u16string& str) {
-        write_int(m_sink, static_cast<std::uint32_t>(str.size()));
+        write_length(str.size());
         for (char16_t c : str) {
             // force writer to use exactly 16 bit
             write_int(m_sink, static_cast<std::uint16_t>(c));
@@ -95,7 +201,7 @@ class binary_writer {
     }
 
     void operator()(const std::u32string& str) {
-        write_int(m_sink, static_cast<std::uint32_t>(str.size()));
+        write_length(str.size());
         for (char32_t c : str) {
             // force writer to use exactly 32 bit
             write_int(m_sink, static_cast<std::uint32_t>(c));
@@ -105,34 +211,108 @@ class binary_writer {
  private:
 
     util::buffer* m_sink;
+    std::uint32_t m_format;
 
 };
 
 } // namespace <anonymous>
 
-binary_serializer::binary_serializer(util::buffer* buf, actor_addressing* ptr)
-: super(ptr), m_sink(buf) { }
+binary_serializer::binary_serializer(util::buffer* buf,
+                                     actor_addressing* ptr,
+                                     type_lookup_table* outgoing_types)
+: super(ptr), m_sink(buf), m_outgoing_types(outgoing_types)
+, m_format(default_binary_format), m_type_names(nullptr)
+, m_type_names_offset(0) { }
+
+void binary_serializer::collect_type_names(type_name_list* names) {
+    m_type_names = names;
+    m_type_names_offset = m_sink->size();
+}
 
 void binary_serializer::begin_object(const std::string& tname) {
-    binary_writer::write_string(m_sink, tname);
+    if (m_type_names) {
+        m_type_names->emplace_back(m_sink->size() - m_type_names_offset,
+                                   tname);
+    }
+    else if (m_outgoing_types) {
+        // id 0 announces a new type name that gets the next free id
+        auto res = m_outgoing_types->add(tname);
+        if (res.second) {
+            binary_writer::write_varint(m_sink, 0);
+            binary_writer(m_sink, m_format)(tname);
+        }
+        else binary_writer::write_varint(m_sink, res.first);
+    }
+    else binary_writer(m_sink, m_format)(tname);
 }
 
 void binary_serializer::end_object() { }
 
 void binary_serializer::begin_sequence(size_t list_size) {
-    binary_writer::write_int(m_sink, static_cast<std::uint32_t>(list_size));
+    binary_writer(m_sink, m_format).write_length(list_size);
 }
 
 void binary_serializer::end_sequence() { }
 
 void binary_serializer::write_value(const primitive_variant& value) {
-    value.apply(binary_writer(m_sink));
+    value.apply(binary_writer(m_sink, m_format));
 }
 
 void binary_serializer::write_raw(size_t num_bytes, const void* data) {
     m_sink->write(num_bytes, data, grow_if_needed);
 }
 
+void binary_serializer::write_array(primitive_type ptype,
+                                    size_t num,
+                                    const void* values) {
+    // produces the same output as writing each element separately
+    binary_writer bw(m_sink, m_format);
+    switch (ptype) {
+     case pt_int8:   bw.write_int_array<std::int8_t>(num, values);   break;
+     case pt_int16:  bw.write_int_array<std::int16_t>(num, values);  break;
+     case pt_int32:  bw.write_int_array<std::int32_t>(num, values);  break;
+     case pt_int64:  bw.write_int_array<std::int64_t>(num, values);  break;
+     case pt_uint8:  bw.write_int_array<std::uint8_t>(num, values);  break;
+     case pt_uint16: bw.write_int_array<std::uint16_t>(num, values); break;
+     case pt_uint32: bw.write_int_array<std::uint32_t>(num, values); break;
+     case pt_uint64: bw.write_int_array<std::uint64_t>(num, values); break;
+     case pt_float:
+        if (m_format & native_floats) {
+            binary_writer::write_ieee754_array<std::uint32_t, float>(m_sink, num, values);
+        }
+        else super::write_array(ptype, num, values);
+        break;
+     case pt_double:
+        if (m_format & native_floats) {
+            binary_writer::write_ieee754_array<std::uint64_t, double>(m_sink, num, values);
+        }
+        else super::write_array(ptype, num, values);
+        break;
+     default:
+        super::write_array(ptype, num, values);
+    }
+}
+
+template<typename T>
+void binary_serializer::write(const T& value) {
+    binary_writer(m_sink, m_format)(value);
+}
+
+template void binary_serializer::write(const std::int8_t&);
+template void binary_serializer::write(const std::int16_t&);
+template void binary_serializer::write(const std::int32_t&);
+template void binary_serializer::write(const std::int64_t&);
+template void binary_serializer::write(const std::uint8_t&);
+template void binary_serializer::write(const std::uint16_t&);
+template void binary_serializer::write(const std::uint32_t&);
+template void binary_serializer::write(const std::uint64_t&);
+template void binary_serializer::write(const float&);
+template void binary_serializer::write(const double&);
+template void binary_serializer::write(const long double&);
+template void binary_serializer::write(const std::string&);
+template void binary_serializer::write(const std::u16string&);
+template void binary_serializer::write(const std::u32string&);
+
 void binary_serializer::write_tuple(size_t size,
                                     const primitive_variant* values) {
     const primitive_variant* end = values + size;
@@ -0,0 +1,92 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <cstring>
+#include <stdexcept>
+
+#include "cppa/util/blob.hpp"
+
+namespace cppa { namespace util {
+
+namespace {
+
+// owns the copied data of a blob
+class blob_storage : public ref_counted {
+
+ public:
+
+    blob_storage(const void* data, size_t num_bytes)
+    : m_data(new char[num_bytes]) {
+        memcpy(m_data, data, num_bytes);
+    }
+
+    ~blob_storage() {
+        delete[] m_data;
+    }
+
+    inline const char* data() const { return m_data; }
+
+ private:
+
+    char* m_data;
+
+};
+
+} // namespace <anonymous>
+
+blob::blob() : m_data(nullptr), m_size(0) { }
+
+blob::blob(const void* data, size_t num_bytes) : m_data(nullptr), m_size(0) {
+    if (num_bytes > 0) {
+        auto storage = new blob_storage(data, num_bytes);
+        m_owner.reset(storage);
+        m_data = storage->data();
+        m_size = num_bytes;
+    }
+}
+
+blob::blob(intrusive_ptr<ref_counted> owner, const char* data, size_t num_bytes)
+: m_owner(std::move(owner)), m_data(data), m_size(num_bytes) { }
+
+blob blob::slice(size_t offset, size_t num_bytes) const {
+    if (offset > m_size || num_bytes > m_size - offset) {
+        throw std::out_of_range("blob::slice()");
+    }
+    return {m_owner, m_data + offset, num_bytes};
+}
+
+bool operator==(const blob& lhs, const blob& rhs) {
+    return    lhs.size() == rhs.size()
+           && (   lhs.data() == rhs.data()
+               || memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+
+} } // namespace cppa::util
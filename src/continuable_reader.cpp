@@ -33,9 +33,24 @@
 
 namespace cppa { namespace network {
 
-continuable_reader::continuable_reader(native_socket_type rd) : m_rd(rd) { }
+continuable_reader::continuable_reader(native_socket_type rd)
+: m_rd(rd), m_loop_id(0) { }
 
 continuable_io* continuable_reader::as_io() { return nullptr; }
 
+completion_mode continuable_reader::completion() const {
+    return completion_mode::none;
+}
+
+util::buffer* continuable_reader::read_buffer() { return nullptr; }
+
+continue_reading_result continuable_reader::read_completed(size_t) {
+    return read_failure;
+}
+
+continue_reading_result continuable_reader::accepted(native_socket_type) {
+    return read_failure;
+}
+
 
 } } // namespace cppa::network
@@ -112,7 +112,8 @@ decorated_names_map::decorated_names_map() {
         { "std::basic_string<@u32,std::char_traits<@u32>,std::allocator<@u32>>", "@u32str"},
         { "std::map<@str,@str,std::less<@str>,std::allocator<std::pair<const @str,@str>>>", "@strmap" },
         { "std::string", "@str" }, // GCC
-        { "cppa::util::void_type", "@0" }
+        { "cppa::util::void_type", "@0" },
+        { "cppa::util::blob", "@blob" }
     };
     m_map = move(tmp);
 }
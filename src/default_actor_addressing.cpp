@@ -28,6 +28,7 @@
 \******************************************************************************/
 
 
+#include <mutex>
 #include <cstdint>
 
 #include "cppa/logging.hpp"
@@ -36,9 +37,12 @@
 #include "cppa/deserializer.hpp"
 #include "cppa/primitive_variant.hpp"
 
+#include "cppa/network/default_protocol.hpp"
 #include "cppa/network/default_actor_proxy.hpp"
 #include "cppa/network/default_actor_addressing.hpp"
 
+#include "cppa/util/shared_lock_guard.hpp"
+
 #include "cppa/detail/actor_registry.hpp"
 #include "cppa/detail/singleton_manager.hpp"
 
@@ -84,7 +88,7 @@ void default_actor_addressing::write(serializer* sink, const actor_ptr& ptr) {
 
 actor_ptr default_actor_addressing::read(deserializer* source) {
     CPPA_REQUIRE(source != nullptr);
-    auto cname = source->seek_object();
+    auto& cname = source->seek_object();
     if (cname == "@0") {
         CPPA_LOG_DEBUG("deserialized nullptr");
         source->begin_object("@0");
@@ -113,16 +117,19 @@ actor_ptr default_actor_addressing::read(deserializer* source) {
 }
 
 size_t default_actor_addressing::count_proxies(const process_information& inf) {
+    util::shared_lock_guard<util::shared_spinlock> guard(m_lock);
     auto i = m_proxies.find(inf);
     return (i != m_proxies.end()) ? i->second.size() : 0;
 }
 
 actor_ptr default_actor_addressing::get(const process_information& inf,
                                         actor_id aid) {
-    auto& submap = m_proxies[inf];
-    auto i = submap.find(aid);
-    if (i != submap.end()) {
-        auto result = i->second.promote();
+    util::shared_lock_guard<util::shared_spinlock> guard(m_lock);
+    auto i = m_proxies.find(inf);
+    if (i == m_proxies.end()) return nullptr;
+    auto j = i->second.find(aid);
+    if (j != i->second.end()) {
+        auto result = j->second.promote();
         CPPA_LOG_INFO_IF(!result, "proxy instance expired; "
                                   << CPPA_TARG(inf, to_string) << ", "
                                   << CPPA_ARG(aid));
@@ -134,47 +141,80 @@ actor_ptr default_actor_addressing::get(const process_information& inf,
 void default_actor_addressing::put(const process_information& node,
                                    actor_id aid,
                                    const actor_proxy_ptr& proxy) {
-    auto& submap = m_proxies[node];
-    auto i = submap.find(aid);
-    if (i == submap.end()) {
+    { // lifetime scope of guard
+        std::lock_guard<util::shared_spinlock> guard(m_lock);
+        auto& submap = m_proxies[node];
+        if (submap.count(aid) > 0) {
+            CPPA_LOG_ERROR("a proxy for " << aid << ":" << to_string(node)
+                           << " already exists");
+            return;
+        }
         submap.insert(make_pair(aid, proxy));
-        m_parent->enqueue(node,
-                          {nullptr, nullptr},
-                          make_any_tuple(atom("MONITOR"),
-                                         process_information::get(),
-                                         aid));
-    }
-    else {
-        CPPA_LOG_ERROR("a proxy for " << aid << ":" << to_string(node)
-                       << " already exists");
     }
+    monitor(node, aid);
 }
 
 
 actor_ptr default_actor_addressing::get_or_put(const process_information& inf,
                                                actor_id aid) {
-    auto result = get(inf, aid);
-    if (result == nullptr) {
+    actor_proxy_ptr result;
+    { // lifetime scope of guard; lookup and insertion must be atomic,
+      // because several event loops may read the same address
+        std::lock_guard<util::shared_spinlock> guard(m_lock);
+        auto& submap = m_proxies[inf];
+        auto i = submap.find(aid);
+        if (i != submap.end()) {
+            result = i->second.promote();
+            if (result) return result;
+            CPPA_LOG_INFO("proxy instance expired; "
+                          << CPPA_TARG(inf, to_string) << ", "
+                          << CPPA_ARG(aid));
+        }
         CPPA_LOG_INFO("created new proxy instance; "
                       << CPPA_TARG(inf, to_string) << ", " << CPPA_ARG(aid));
-        auto ptr = make_counted<default_actor_proxy>(aid, new process_information(inf), m_parent);
-        put(inf, aid, ptr);
-        result = ptr;
+        result = make_counted<default_actor_proxy>(aid, new process_information(inf), m_parent);
+        if (i != submap.end()) {
+            CPPA_LOG_ERROR("a proxy for " << aid << ":" << to_string(inf)
+                           << " already exists");
+            return result;
+        }
+        submap.insert(make_pair(aid, result));
     }
+    monitor(inf, aid);
     return result;
 }
 
-auto default_actor_addressing::proxies(process_information& i) -> proxy_map& {
-    return m_proxies[i];
+void default_actor_addressing::monitor(const process_information& node,
+                                       actor_id aid) {
+    auto msg = make_any_tuple(atom("MONITOR"), process_information::get(), aid);
+    if (m_parent->num_loops() == 1) {
+        // we are running in the only event loop
+        m_parent->enqueue(node, {nullptr, nullptr}, move(msg));
+    }
+    else {
+        default_protocol_ptr proto = m_parent;
+        process_information_ptr nptr = new process_information(node);
+        proto->run_later(proto->loop_of(node), [proto, nptr, msg] {
+            proto->enqueue(*nptr, {nullptr, nullptr}, msg);
+        });
+    }
+}
+
+auto default_actor_addressing::proxies(process_information& i) -> proxy_map {
+    util::shared_lock_guard<util::shared_spinlock> guard(m_lock);
+    auto j = m_proxies.find(i);
+    return (j != m_proxies.end()) ? j->second : proxy_map{};
 }
 
 void default_actor_addressing::erase(process_information& inf) {
     CPPA_LOG_TRACE("inf = " << to_string(inf));
+    std::lock_guard<util::shared_spinlock> guard(m_lock);
     m_proxies.erase(inf);
 }
 
 void default_actor_addressing::erase(process_information& inf, actor_id aid) {
     CPPA_LOG_TRACE("inf = " << to_string(inf) << ", aid = " << aid);
+    std::lock_guard<util::shared_spinlock> guard(m_lock);
     auto i = m_proxies.find(inf);
     if (i != m_proxies.end()) {
         i->second.erase(aid);
@@ -32,14 +32,71 @@
 
 #include "cppa/logging.hpp"
 #include "cppa/network/middleman.hpp"
+#include "cppa/network/serialized_payload.hpp"
 #include "cppa/network/default_actor_proxy.hpp"
 
+#include "cppa/detail/memory.hpp"
 #include "cppa/detail/singleton_manager.hpp"
 
 using namespace std;
 
 namespace cppa { namespace network {
 
+namespace {
+
+// forwards a message to a remote node; allocated via memory::create
+// since each message sent to a remote actor creates one instance
+class forward_event : public middleman_event {
+
+    template<typename>
+    friend class detail::basic_memory_cache;
+
+    friend class detail::memory;
+
+ public:
+
+    forward_event(message_header hdr,
+                  any_tuple msg,
+                  process_information_ptr node,
+                  default_protocol_ptr proto,
+                  serialized_payload_ptr payload)
+    : m_hdr(move(hdr)), m_msg(move(msg)), m_node(move(node))
+    , m_proto(move(proto)), m_payload(move(payload)) { }
+
+    void run() {
+        CPPA_LOGF_TRACE("forward_event::run");
+        m_proto->enqueue(*m_node, m_hdr, m_msg, m_payload);
+    }
+
+    void dispose() { detail::memory::dispose(this); }
+
+ private:
+
+    message_header m_hdr;
+    any_tuple m_msg;
+    process_information_ptr m_node;
+    default_protocol_ptr m_proto;
+    serialized_payload_ptr m_payload;
+
+    // a pointer to the outer memory region this instance belongs to
+    detail::instance_wrapper* outer_memory;
+
+};
+
+} // namespace <anonymous>
+
+} } // namespace cppa::network
+
+namespace cppa { namespace detail {
+
+// created by sending threads and released by the middleman
+template<>
+struct use_recycling_pool<network::forward_event> : std::true_type { };
+
+} } // namespace cppa::detail
+
+namespace cppa { namespace network {
+
 default_actor_proxy::default_actor_proxy(actor_id mid,
                                          const process_information_ptr& pinfo,
                                          const default_protocol_ptr& parent)
@@ -50,7 +107,7 @@ default_actor_proxy::~default_actor_proxy() {
     auto aid = id();
     auto node = m_pinf;
     auto proto = m_proto;
-    proto->run_later([aid, node, proto] {
+    proto->run_later(proto->loop_of(*node), [aid, node, proto] {
         CPPA_LOGF_TRACE("lambda from ~default_actor_proxy"
                         << "; node = " << to_string(*node) << ", aid " << aid
                         << ", proto = " << to_string(proto->identifier()));
@@ -69,10 +126,24 @@ void default_actor_proxy::forward_msg(const actor_ptr& sender, any_tuple msg, me
     message_header hdr{sender, this, mid};
     auto node = m_pinf;
     auto proto = m_proto;
-    m_proto->run_later([hdr, msg, node, proto] {
-        CPPA_LOGF_TRACE("lambda from default_actor_proxy::forward_msg");
-        proto->enqueue(*node, hdr, msg);
-    });
+    // serialize on the sending thread rather than in the middleman;
+    // the peer serializes msg again if it guessed the wrong format
+    serialized_payload_ptr payload;
+    try {
+        auto format = default_protocol::binary_format(
+                          default_protocol::supported_features());
+        payload = serialized_payload::from(msg, proto->addressing(), format);
+    }
+    catch (exception& e) {
+        // the middleman retries and reports the error
+        CPPA_LOG_DEBUG("unable to serialize message: " << e.what());
+    }
+    auto loop = proto->loop_of(*node);
+    auto event = detail::memory::create<forward_event>(hdr, move(msg),
+                                                       move(node),
+                                                       move(proto),
+                                                       move(payload));
+    m_proto->run_later(loop, event);
 }
 
 void default_actor_proxy::enqueue(actor* sender, any_tuple msg) {
@@ -30,6 +30,7 @@
 
 #include <cstring>
 #include <cstdint>
+#include <algorithm>
 
 #include "cppa/on.hpp"
 #include "cppa/actor.hpp"
@@ -42,30 +43,72 @@
 #include "cppa/binary_deserializer.hpp"
 
 #include "cppa/detail/demangle.hpp"
+#include "cppa/detail/lazy_tuple.hpp"
 #include "cppa/detail/actor_registry.hpp"
 #include "cppa/detail/singleton_manager.hpp"
 
 #include "cppa/network/middleman.hpp"
 #include "cppa/network/default_peer.hpp"
 #include "cppa/network/message_header.hpp"
+#include "cppa/network/ipv4_io_stream.hpp"
 #include "cppa/network/default_protocol.hpp"
 
 using namespace std;
 
 namespace cppa { namespace network {
 
+namespace {
+
+// set in the size of a message if the lazy_payloads feature is enabled
+// and the payload can be deserialized by a detail::lazy_tuple
+constexpr uint32_t lazy_payload_flag = 0x80000000;
+
+// messages are appended to the last write chunk until it exceeds this size
+constexpr size_t wr_chunk_size = 16 * 1024;
+
+// maximum number of chunks passed to a single write_some call
+constexpr size_t max_wr_slices = 64;
+
+// maximum number of written chunks kept for reuse
+constexpr size_t max_free_chunks = 8;
+
+// minimum size of the read buffer; each read fetches as many
+// frames as fit into the buffer and are available on the socket
+constexpr size_t rd_buf_size = 64 * 1024;
+
+// size of the handshake data sent by a connecting node
+constexpr size_t process_info_size =   sizeof(uint32_t)
+                                     + process_information::node_id_size;
+
+} // namespace <anonymous>
+
 default_peer::default_peer(default_protocol* parent,
                            const input_stream_ptr& in,
                            const output_stream_ptr& out,
-                           process_information_ptr peer_ptr)
+                           process_information_ptr peer_ptr,
+                           std::uint32_t offered_features)
 : super(in->read_handle(), out->write_handle())
 , m_parent(parent), m_in(in), m_out(out)
 , m_state((peer_ptr) ? wait_for_msg_size : wait_for_process_info)
+, m_lazy_payload(false)
 , m_node(peer_ptr)
-, m_has_unwritten_data(false) {
-    m_rd_buf.reset(m_state == wait_for_process_info
-                   ? sizeof(uint32_t) + process_information::node_id_size
-                   : sizeof(uint32_t));
+, m_has_unwritten_data(false)
+, m_rd_frame(new rd_frame)
+, m_rd_pos(0)
+, m_msg_size(0)
+, m_migrate(false)
+, m_wr_offset(0)
+, m_unwritten_bytes(0)
+, m_flush_bytes(default_protocol::flush_bytes())
+, m_flush_delay(default_protocol::flush_delay())
+, m_in_features(0)
+, m_out_features(0)
+, m_offered_features(offered_features)
+, m_features_sent(offered_features != 0)
+, m_incoming_types(std::make_shared<type_lookup_table>()) {
+    // the event loop can read on our behalf if m_in is a plain socket
+    m_completion_reads = dynamic_cast<ipv4_io_stream*>(in.get()) != nullptr;
+    rd_buf().reset(rd_buf_size);
     // state == wait_for_msg_size iff peer was created using remote_peer()
     // in this case, this peer must be erased if no proxy of it remains
     m_erase_on_last_proxy_exited = m_state == wait_for_msg_size;
@@ -81,7 +124,7 @@ void default_peer::disconnected() {
     CPPA_LOG_TRACE("node = " << (m_node ? to_string(*m_node) : "nullptr"));
     if (m_node) {
         // kill all proxies
-        auto& children = m_parent->addressing()->proxies(*m_node);
+        auto children = m_parent->addressing()->proxies(*m_node);
         for (auto& kvp : children) {
             auto ptr = kvp.second.promote();
             if (ptr) ptr->enqueue(nullptr,
@@ -92,6 +135,45 @@ void default_peer::disconnected() {
     }
 }
 
+type_lookup_table* default_peer::incoming_types() {
+    return (m_in_features & default_protocol::type_dictionary)
+           ? m_incoming_types.get()
+           : nullptr;
+}
+
+type_lookup_table* default_peer::outgoing_types() {
+    return (m_out_features & default_protocol::type_dictionary)
+           ? &m_outgoing_types
+           : nullptr;
+}
+
+std::uint32_t default_peer::incoming_format() const {
+    return default_protocol::binary_format(m_in_features);
+}
+
+std::uint32_t default_peer::outgoing_format() const {
+    return default_protocol::binary_format(m_out_features);
+}
+
+void default_peer::negotiate(std::uint32_t remote_features) {
+    CPPA_LOG_TRACE(CPPA_ARG(remote_features));
+    // the acceptor announces its features right after the handshake,
+    // the connecting node replies and the acceptor confirms; each node
+    // switches to the common features right after announcing its own,
+    // i.e., messages following a FEATURES message use the common
+    // features if the remote node knew our features when sending it
+    if (m_features_sent) m_in_features = m_offered_features & remote_features;
+    auto offered = m_features_sent ? m_offered_features
+                                   : default_protocol::supported_features();
+    auto features = offered & remote_features;
+    if (features != m_out_features) {
+        m_offered_features = offered;
+        m_features_sent = true;
+        enqueue(make_any_tuple(atom("FEATURES"), offered));
+        m_out_features = features;
+    }
+}
+
 void default_peer::io_failed() {
     CPPA_LOG_TRACE("");
     disconnected();
@@ -100,20 +182,83 @@ void default_peer::io_failed() {
 continue_reading_result default_peer::continue_reading() {
     CPPA_LOG_TRACE("");
     for (;;) {
-        try { m_rd_buf.append_from(m_in.get()); }
+        auto& buf = rd_buf();
+        auto before = buf.size();
+        try { buf.append_from(m_in.get()); }
         catch (exception&) {
             disconnected();
             return read_failure;
         }
-        if (!m_rd_buf.full()) return read_continue_later; // try again later
+        if (buf.size() == before) {
+            default_protocol::add_statistics({1, 0, 0, 0});
+            return read_continue_later; // try again later
+        }
+        // the socket has no more data if it didn't fill the buffer
+        bool drained = !buf.full();
+        bool migrated = false;
+        auto result = parse_rd_buf(migrated);
+        if (result == read_failure) return read_failure;
+        if (drained || migrated) return read_continue_later;
+    }
+}
+
+completion_mode default_peer::completion() const {
+    return m_completion_reads ? completion_mode::read : completion_mode::none;
+}
+
+util::buffer* default_peer::read_buffer() {
+    return &rd_buf();
+}
+
+continue_reading_result default_peer::read_completed(size_t num_bytes) {
+    CPPA_LOG_TRACE(CPPA_ARG(num_bytes));
+    if (num_bytes == 0) {
+        // connection closed by the remote node
+        disconnected();
+        return read_failure;
+    }
+    rd_buf().appended(num_bytes);
+    bool migrated = false;
+    return parse_rd_buf(migrated);
+}
+
+continue_reading_result default_peer::parse_rd_buf(bool& migrated) {
+    default_protocol::io_statistics stats{1, 0, 0, 0};
+    auto result = read_frames(stats.messages_read);
+    default_protocol::add_statistics(stats);
+    if (result == read_failure) return read_failure;
+    if (m_migrate) {
+        m_migrate = false;
+        m_parent->migrate(this);
+        migrated = true;
+        return read_continue_later;
+    }
+    prepare_rd_buf();
+    return read_continue_later;
+}
+
+continue_reading_result default_peer::resume_reading() {
+    CPPA_LOG_TRACE("");
+    default_protocol::io_statistics stats{0, 0, 0, 0};
+    auto result = read_frames(stats.messages_read);
+    default_protocol::add_statistics(stats);
+    if (result != read_failure) prepare_rd_buf();
+    return result;
+}
+
+continue_reading_result default_peer::read_frames(std::uint64_t& num_messages) {
+    for (;;) {
+        auto available = rd_buf().size() - m_rd_pos;
+        if (available < bytes_needed()) return read_continue_later;
+        auto first = rd_buf().data() + m_rd_pos;
         switch (m_state) {
             case wait_for_process_info: {
                 //DEBUG("peer_connection::continue_reading: "
                 //      "wait_for_process_info");
                 uint32_t process_id;
                 process_information::node_id_type node_id;
-                memcpy(&process_id, m_rd_buf.data(), sizeof(uint32_t));
-                memcpy(node_id.data(), m_rd_buf.data() + sizeof(uint32_t),
+                memcpy(&process_id, first, sizeof(uint32_t));
+                memcpy(node_id.data(), first + sizeof(uint32_t),
                        process_information::node_id_size);
                 m_node.reset(new process_information(process_id, node_id));
                 if (*process_information::get() == *m_node) {
@@ -123,17 +268,28 @@ continue_reading_result default_peer::continue_reading() {
                     return read_failure;
                 }
                 CPPA_LOG_DEBUG("read process info: " << to_string(*m_node));
-                m_parent->register_peer(*m_node, this);
                 // initialization done
+                m_rd_pos += process_info_size;
                 m_state = wait_for_msg_size;
-                m_rd_buf.reset(sizeof(uint32_t));
+                if (m_parent->loop_of(*m_node) != loop_id()) {
+                    // remaining frames are parsed by the event loop
+                    // of m_node, see default_protocol::migrate
+                    m_migrate = true;
+                    return read_continue_later;
+                }
+                m_parent->register_peer(*m_node, this);
                 break;
             }
             case wait_for_msg_size: {
                 //DEBUG("peer_connection::continue_reading: wait_for_msg_size");
                 uint32_t msg_size;
-                memcpy(&msg_size, m_rd_buf.data(), sizeof(uint32_t));
-                m_rd_buf.reset(msg_size);
+                memcpy(&msg_size, first, sizeof(uint32_t));
+                if (m_in_features & default_protocol::lazy_payloads) {
+                    m_lazy_payload = (msg_size & lazy_payload_flag) != 0;
+                    msg_size &= ~lazy_payload_flag;
+                }
+                m_msg_size = msg_size;
+                m_rd_pos += sizeof(uint32_t);
                 m_state = read_message;
                 break;
             }
@@ -141,21 +297,38 @@ continue_reading_result default_peer::continue_reading() {
                 //DEBUG("peer_connection::continue_reading: read_message");
                 message_header hdr;
                 any_tuple msg;
-                binary_deserializer bd(m_rd_buf.data(), m_rd_buf.size(),
-                                       m_parent->addressing());
-                try {
-                    m_meta_hdr->deserialize(&hdr, &bd);
-                    m_meta_msg->deserialize(&msg, &bd);
-                }
-                catch (exception& e) {
-                    CPPA_LOG_ERROR("exception during read_message: "
-                                   << detail::demangle(typeid(e))
-                                   << ", what(): " << e.what());
-                    return read_failure;
+                { // lifetime scope of bd, which shares m_rd_frame
+                    binary_deserializer bd(first, m_msg_size,
+                                           m_parent->addressing(),
+                                           incoming_types());
+                    bd.format(incoming_format());
+                    bd.data_owner(m_rd_frame);
+                    try {
+                        m_meta_hdr->deserialize(&hdr, &bd);
+                        if (m_lazy_payload) {
+                            // leaves deserialization to the receiver
+                            auto data = bd.read_blob(bd.remaining());
+                            msg = any_tuple{new detail::lazy_tuple(
+                                              std::move(data),
+                                              incoming_format(),
+                                              incoming_types()
+                                              ? m_incoming_types
+                                              : nullptr)};
+                        }
+                        else m_meta_msg->deserialize(&msg, &bd);
+                    }
+                    catch (exception& e) {
+                        CPPA_LOG_ERROR("exception during read_message: "
+                                       << detail::demangle(typeid(e))
+                                       << ", what(): " << e.what());
+                        return read_failure;
+                    }
                 }
                 CPPA_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
                 //DEBUG("<-- " << to_string(msg));
-                match(msg) (
+                // lazy payloads are never system messages
+                if (m_lazy_payload) deliver(hdr, move(msg));
+                else match(msg) (
                     // monitor messages are sent automatically whenever
                     // actor_proxy_cache creates a new proxy
                     // note: aid is the *original* actor id
@@ -171,11 +344,16 @@ continue_reading_result default_peer::continue_reading() {
                     on(atom("UNLINK"), arg_match) >> [&](const actor_ptr& ptr) {
                         unlink(hdr.sender, ptr);
                     },
+                    // sent without receiver, thus ignored by older nodes
+                    on(atom("FEATURES"), arg_match) >> [&](std::uint32_t features) {
+                        negotiate(features);
+                    },
                     others() >> [&] {
                         deliver(hdr, move(msg));
                     }
                 );
-                m_rd_buf.reset(sizeof(uint32_t));
+                ++num_messages;
+                m_rd_pos += m_msg_size;
                 m_state = wait_for_msg_size;
                 break;
             }
@@ -183,7 +361,58 @@ continue_reading_result default_peer::continue_reading() {
                 CPPA_CRITICAL("illegal state");
             }
         }
-        // try to read more (next iteration)
+    }
+}
+
+size_t default_peer::bytes_needed() const {
+    switch (m_state) {
+        case wait_for_process_info: return process_info_size;
+        case wait_for_msg_size: return sizeof(uint32_t);
+        default: return m_msg_size;
+    }
+}
+
+void default_peer::prepare_rd_buf() {
+    auto unparsed = rd_buf().size() - m_rd_pos;
+    if (m_rd_pos > 0) {
+        if (m_rd_frame->unique()) rd_buf().erase_leading(m_rd_pos);
+        else {
+            // blobs of delivered messages still refer to the frame,
+            // thus the unparsed bytes are copied to another frame
+            auto old_frame = m_rd_frame;
+            recycle_rd_frame();
+            rd_buf().reset(rd_buf_size);
+            rd_buf().write(unparsed, old_frame->buf.data() + m_rd_pos,
+                           util::grow_if_needed);
+        }
+        m_rd_pos = 0;
+    }
+    // make room for the remainder of a frame that straddles the
+    // buffer boundary, even if it exceeds rd_buf_size
+    auto required = max(rd_buf_size, bytes_needed());
+    if (rd_buf().final_size() < required) {
+        rd_buf().acquire(required - rd_buf().size());
+    }
+}
+
+
+
+void default_peer::recycle_rd_frame() {
+    // at most this many frames are kept for reuse; frames that are
+    // dropped from the list are released by their last blob
+    static constexpr size_t max_shared_frames = 8;
+    m_shared_frames.push_back(std::move(m_rd_frame));
+    auto i = find_if(m_shared_frames.begin(), m_shared_frames.end(),
+                     [](const rd_frame_ptr& ptr) { return ptr->unique(); });
+    if (i != m_shared_frames.end()) {
+        m_rd_frame = std::move(*i);
+        m_shared_frames.erase(i);
+    }
+    else {
+        m_rd_frame.reset(new rd_frame);
+        if (m_shared_frames.size() > max_shared_frames) {
+            m_shared_frames.erase(m_shared_frames.begin());
+        }
     }
 }
 
@@ -220,7 +449,7 @@ void default_peer::monitor(const actor_ptr&,
         CPPA_LOG_DEBUG("attach functor to " << entry.first.get());
         default_protocol_ptr proto = m_parent;
         entry.first->attach_functor([=](uint32_t reason) {
-            proto->run_later([=] {
+            proto->run_later(proto->loop_of(*node), [=] {
                 CPPA_LOGF_TRACE("lambda from default_peer::monitor");
                 auto p = proto->get_peer(*node);
                 if (p) p->enqueue(make_any_tuple(atom("KILL_PROXY"), pself, aid, reason));
@@ -317,33 +546,80 @@ void default_peer::unlink(const actor_ptr& sender, const actor_ptr& ptr) {
     else sender->unlink_from(ptr);
 }
 
-continue_writing_result default_peer::continue_writing() {
-    CPPA_LOG_TRACE("");
-    CPPA_LOG_DEBUG_IF(!m_has_unwritten_data, "nothing to write (done)");
-    while (m_has_unwritten_data) {
+util::buffer& default_peer::wr_buf() {
+    if (m_wr_chunks.empty() || m_wr_chunks.back().size() >= wr_chunk_size) {
+        if (m_free_chunks.empty()) m_wr_chunks.emplace_back();
+        else {
+            m_wr_chunks.push_back(move(m_free_chunks.back()));
+            m_free_chunks.pop_back();
+        }
+    }
+    return m_wr_chunks.back();
+}
+
+continue_writing_result default_peer::flush() {
+    while (m_unwritten_bytes > 0) {
+        output_slice slices[max_wr_slices];
+        size_t num_slices = 0;
+        size_t total = 0;
+        for (auto& chunk : m_wr_chunks) {
+            if (num_slices == max_wr_slices) break;
+            auto offset = (num_slices == 0) ? m_wr_offset : 0;
+            slices[num_slices].data = chunk.data() + offset;
+            slices[num_slices].size = chunk.size() - offset;
+            total += slices[num_slices].size;
+            ++num_slices;
+        }
         size_t written;
-        try { written = m_out->write_some(m_wr_buf.data(), m_wr_buf.size()); }
+        default_protocol::add_statistics({0, 0, 1, 0});
+        try { written = m_out->write_some(slices, num_slices); }
         catch (exception& e) {
             CPPA_LOG_ERROR(to_verbose_string(e));
             static_cast<void>(e); // keep compiler happy
-            disconnected();
             return write_failure;
         }
-        if (written != m_wr_buf.size()) {
-            CPPA_LOG_DEBUG("tried to write " << m_wr_buf.size() << "bytes, "
+        m_unwritten_bytes -= written;
+        m_wr_offset += written;
+        // release completely written chunks
+        while (!m_wr_chunks.empty()
+               && m_wr_offset >= m_wr_chunks.front().size()) {
+            auto& chunk = m_wr_chunks.front();
+            m_wr_offset -= chunk.size();
+            if (m_free_chunks.size() < max_free_chunks) {
+                chunk.clear();
+                m_free_chunks.push_back(move(chunk));
+            }
+            m_wr_chunks.pop_front();
+        }
+        if (written != total) {
+            CPPA_LOG_DEBUG("tried to write " << total << "bytes, "
                            << "only " << written << " bytes written");
-            m_wr_buf.erase_leading(written);
             return write_continue_later;
         }
-        else {
-            m_wr_buf.reset();
-            m_has_unwritten_data = false;
-            CPPA_LOG_DEBUG("write done, " << written << "bytes written");
+        CPPA_LOG_DEBUG("write done, " << written << "bytes written");
+    }
+    m_has_unwritten_data = false;
+    return write_done;
+}
+
+continue_writing_result default_peer::continue_writing() {
+    CPPA_LOG_TRACE("");
+    CPPA_LOG_DEBUG_IF(!m_has_unwritten_data, "nothing to write (done)");
+    while (m_has_unwritten_data) {
+        switch (flush()) {
+            case write_failure:
+                disconnected();
+                return write_failure;
+            case write_continue_later:
+                return write_continue_later;
+            default:
+                break;
         }
-        // try to write next message in queue
-        while (!m_has_unwritten_data && !queue().empty()) {
+        // serialize queued messages up to the
+        // byte threshold and write them at once
+        while (!queue().empty() && !write_buffer_full()) {
             auto tmp = queue().pop();
-            enqueue(tmp.first, tmp.second);
+            enqueue(tmp.hdr, tmp.msg, tmp.payload);
         }
     }
     if (erase_on_last_proxy_exited() && !has_unwritten_data()) {
@@ -358,14 +634,38 @@ continuable_io* default_peer::as_io() {
     return this;
 }
 
-void default_peer::enqueue(const message_header& hdr, const any_tuple& msg) {
+void default_peer::enqueue(const message_header& hdr,
+                           const any_tuple& msg,
+                           const serialized_payload_ptr& payload) {
     CPPA_LOG_TRACE("");
-    binary_serializer bs(&m_wr_buf, m_parent->addressing());
+    auto& buf = wr_buf();
+    binary_serializer bs(&buf, m_parent->addressing(), outgoing_types());
+    bs.format(outgoing_format());
     uint32_t size = 0;
-    auto before = m_wr_buf.size();
-    m_wr_buf.write(sizeof(uint32_t), &size, util::grow_if_needed);
-    try { bs << hdr << msg; }
+    auto before = buf.size();
+    auto types_before = m_outgoing_types.size();
+    bool lazy = false;
+    buf.write(sizeof(uint32_t), &size, util::grow_if_needed);
+    try {
+        // the sender guesses the format of this connection
+        auto pl = payload;
+        if (pl == nullptr || pl->format() != outgoing_format()) {
+            pl = serialized_payload::from(msg, m_parent->addressing(),
+                                          outgoing_format());
+        }
+        // system messages have no receiver and are always
+        // deserialized by the middleman
+        lazy =    (m_out_features & default_protocol::lazy_payloads)
+               && hdr.receiver != nullptr
+               && pl->self_contained(outgoing_types());
+        bs << hdr;
+        pl->write_to(bs);
+    }
     catch (exception& e) {
+        // discard partially serialized message, including all type
+        // names that were introduced by it
+        buf.erase_trailing(buf.size() - before);
+        m_outgoing_types.truncate(types_before);
         CPPA_LOG_ERROR(to_verbose_string(e));
         cerr << "*** exception in default_peer::enqueue; "
              << to_verbose_string(e)
@@ -373,15 +673,31 @@ void default_peer::enqueue(const message_header& hdr, const any_tuple& msg) {
         return;
     }
     CPPA_LOG_DEBUG("serialized: " << to_string(hdr) << " " << to_string(msg));
-    size = (m_wr_buf.size() - before) - sizeof(std::uint32_t);
+    m_unwritten_bytes += buf.size() - before;
+    default_protocol::add_statistics({0, 0, 0, 1});
+    size = (buf.size() - before) - sizeof(std::uint32_t);
+    if (lazy) size |= lazy_payload_flag;
     // update size in buffer
-    memcpy(m_wr_buf.data() + before, &size, sizeof(std::uint32_t));
+    memcpy(buf.data() + before, &size, sizeof(std::uint32_t));
     CPPA_LOG_DEBUG_IF(m_has_unwritten_data, "still registered for writing");
     if (!m_has_unwritten_data) {
+        // written once the middleman handled all pending events
         CPPA_LOG_DEBUG("register for writing");
         m_has_unwritten_data = true;
+        m_wr_since = chrono::steady_clock::now();
         m_parent->continue_writer(this);
     }
+    else if (   m_unwritten_bytes >= m_flush_bytes
+             || chrono::steady_clock::now() - m_wr_since >= m_flush_delay) {
+        // don't wait for the end of a burst; errors are
+        // reported once the middleman calls continue_writing()
+        CPPA_LOG_DEBUG("flush during burst");
+        if (flush() == write_done) {
+            // continue_writing() unregisters this peer
+            m_has_unwritten_data = true;
+            m_wr_since = chrono::steady_clock::now();
+        }
+    }
 }
 
 } } // namespace cppa::network
@@ -28,15 +28,23 @@
 \******************************************************************************/
 
 
+#include <cstring>
 #include <iostream>
 #include <exception>
 
+#include "cppa/atom.hpp"
 #include "cppa/logging.hpp"
+#include "cppa/any_tuple.hpp"
 #include "cppa/to_string.hpp"
+#include "cppa/binary_serializer.hpp"
 #include "cppa/process_information.hpp"
 
+#include "cppa/util/buffer.hpp"
+
 #include "cppa/network/default_protocol.hpp"
 #include "cppa/network/default_peer.hpp"
+#include "cppa/network/ipv4_io_stream.hpp"
+#include "cppa/network/message_header.hpp"
 #include "cppa/network/default_peer_acceptor.hpp"
 
 #include "cppa/detail/demangle.hpp"
@@ -60,29 +68,67 @@ continue_reading_result default_peer_acceptor::continue_reading() {
             static_cast<void>(e); // keep compiler happy
             return read_failure;
         }
-        if (opt) {
-            auto& pair = *opt;
-            auto& pself = process_information::get();
-            uint32_t process_id = pself->process_id();
-            try {
-                actor_id aid = published_actor()->id();
-                pair.second->write(&aid, sizeof(actor_id));
-                pair.second->write(&process_id, sizeof(uint32_t));
-                pair.second->write(pself->node_id().data(),
-                                   pself->node_id().size());
-                m_parent->new_peer(pair.first, pair.second);
-            }
-            catch (exception& e) {
-                CPPA_LOG_ERROR(to_verbose_string(e));
-                cerr << "*** exception while sending actor and process id; "
-                     << to_verbose_string(e)
-                     << endl;
-            }
-        }
+        if (opt) new_connection(*opt);
         else return read_continue_later;
    }
 }
 
+completion_mode default_peer_acceptor::completion() const {
+    // the event loop can accept on our behalf if m_ptr is a plain socket
+    return dynamic_cast<ipv4_acceptor*>(m_ptr.get()) != nullptr
+           ? completion_mode::accept
+           : completion_mode::none;
+}
+
+continue_reading_result default_peer_acceptor::accepted(native_socket_type fd) {
+    CPPA_LOG_TRACE(CPPA_ARG(fd));
+    io_stream_ptr ptr;
+    try { ptr = ipv4_io_stream::from_native_socket(fd); }
+    catch (exception& e) {
+        CPPA_LOG_ERROR(to_verbose_string(e));
+        static_cast<void>(e); // keep compiler happy
+        closesocket(fd);
+        return read_failure;
+    }
+    new_connection({ptr, ptr});
+    return read_continue_later;
+}
+
+void default_peer_acceptor::new_connection(const io_stream_ptr_pair& pair) {
+    auto& pself = process_information::get();
+    uint32_t process_id = pself->process_id();
+    try {
+        actor_id aid = published_actor()->id();
+        pair.second->write(&aid, sizeof(actor_id));
+        pair.second->write(&process_id, sizeof(uint32_t));
+        pair.second->write(pself->node_id().data(),
+                           pself->node_id().size());
+        auto features = default_protocol::supported_features();
+        if (features != 0) {
+            // announce our features in a message without receiver,
+            // which is ignored by nodes that don't support any
+            // features (see default_peer::negotiate)
+            util::buffer buf;
+            binary_serializer bs(&buf, m_parent->addressing());
+            bs.format(legacy_binary_format);
+            uint32_t size = 0;
+            buf.write(sizeof(uint32_t), &size, util::grow_if_needed);
+            bs << message_header{nullptr, nullptr}
+               << make_any_tuple(atom("FEATURES"), features);
+            size = static_cast<uint32_t>(buf.size() - sizeof(uint32_t));
+            memcpy(buf.data(), &size, sizeof(uint32_t));
+            pair.second->write(buf.data(), buf.size());
+        }
+        m_parent->new_peer(pair.first, pair.second, nullptr, features);
+    }
+    catch (exception& e) {
+        CPPA_LOG_ERROR(to_verbose_string(e));
+        cerr << "*** exception while sending actor and process id; "
+             << to_verbose_string(e)
+             << endl;
+    }
+}
+
 void default_peer_acceptor::io_failed() {
     CPPA_LOG_INFO("removed default_peer_acceptor "
                   << this << " due to an IO failure");
@@ -28,8 +28,10 @@
 \******************************************************************************/
 
 
+#include <atomic>
 #include <future>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 
 #include "cppa/logging.hpp"
@@ -53,12 +55,87 @@ using namespace cppa::detail;
 namespace cppa { namespace network {
 
 default_protocol::default_protocol(abstract_middleman* parent)
-: super(parent), m_addressing(this) { }
+: super(parent), m_addressing(this), m_peers(parent->num_loops()) { }
 
 atom_value default_protocol::identifier() const {
     return atom("DEFAULT");
 }
 
+namespace {
+
+std::atomic<std::uint32_t> s_supported_features{default_protocol::default_features};
+
+std::atomic<size_t> s_flush_bytes{64 * 1024};
+
+std::atomic<std::chrono::microseconds::rep> s_flush_delay{1000};
+
+std::atomic<std::uint64_t> s_read_calls{0};
+std::atomic<std::uint64_t> s_messages_read{0};
+std::atomic<std::uint64_t> s_write_calls{0};
+std::atomic<std::uint64_t> s_messages_written{0};
+
+inline double per_message(std::uint64_t calls, std::uint64_t messages) {
+    return messages > 0 ? static_cast<double>(calls) / messages : 0.0;
+}
+
+} // namespace <anonymous>
+
+std::uint32_t default_protocol::supported_features() {
+    return s_supported_features.load();
+}
+
+void default_protocol::supported_features(std::uint32_t features) {
+    s_supported_features = features & (  type_dictionary
+                                       | ieee754_floats
+                                       | compact_integers
+                                       | lazy_payloads);
+}
+
+size_t default_protocol::flush_bytes() {
+    return s_flush_bytes.load();
+}
+
+std::chrono::microseconds default_protocol::flush_delay() {
+    return std::chrono::microseconds{s_flush_delay.load()};
+}
+
+void default_protocol::flush_policy(size_t max_bytes,
+                                    std::chrono::microseconds max_delay) {
+    s_flush_bytes = max_bytes;
+    s_flush_delay = max_delay.count();
+}
+
+double default_protocol::io_statistics::reads_per_message() const {
+    return per_message(read_calls, messages_read);
+}
+
+double default_protocol::io_statistics::writes_per_message() const {
+    return per_message(write_calls, messages_written);
+}
+
+default_protocol::io_statistics default_protocol::statistics() {
+    return {s_read_calls.load(), s_messages_read.load(),
+            s_write_calls.load(), s_messages_written.load()};
+}
+
+void default_protocol::add_statistics(const io_statistics& stats) {
+    // counters are updated by the middleman only
+    auto add = [](std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+        if (value > 0) counter.fetch_add(value, std::memory_order_relaxed);
+    };
+    add(s_read_calls, stats.read_calls);
+    add(s_messages_read, stats.messages_read);
+    add(s_write_calls, stats.write_calls);
+    add(s_messages_written, stats.messages_written);
+}
+
+std::uint32_t default_protocol::binary_format(std::uint32_t features) {
+    std::uint32_t result = legacy_binary_format;
+    if (features & ieee754_floats) result |= native_floats;
+    if (features & compact_integers) result |= varint_integers;
+    return result;
+}
+
 void default_protocol::publish(const actor_ptr& whom, variant_args args) {
     CPPA_LOG_TRACE(CPPA_TARG(whom, to_string)
                    << ", args.size() = " << args.size());
@@ -111,17 +188,26 @@ void default_protocol::unpublish(const actor_ptr& whom) {
     });
 }
 
+size_t default_protocol::loop_of(const process_information& node) const {
+    if (m_peers.size() == 1) return 0;
+    // node IDs are hash values, i.e., the leading bytes are well distributed
+    std::uint32_t result;
+    memcpy(&result, node.node_id().data(), sizeof(result));
+    return (result ^ node.process_id()) % m_peers.size();
+}
+
 void default_protocol::register_peer(const process_information& node,
                                      default_peer* ptr) {
     CPPA_LOG_TRACE("node = " << to_string(node) << ", ptr = " << ptr);
-    auto& entry = m_peers[node];
+    CPPA_REQUIRE(ptr->loop_id() == loop_of(node));
+    auto& entry = m_peers[loop_of(node)][node];
     if (entry.impl == nullptr) {
         if (entry.queue == nullptr) entry.queue.emplace();
         ptr->set_queue(entry.queue);
         entry.impl.reset(ptr);
         if (!entry.queue->empty()) {
             auto tmp = entry.queue->pop();
-            ptr->enqueue(tmp.first, tmp.second);
+            ptr->enqueue(tmp.hdr, tmp.msg, tmp.payload);
         }
     }
     else { CPPA_LOG_ERROR("peer " << to_string(node) << " already defined"); }
@@ -129,8 +215,9 @@ void default_protocol::register_peer(const process_information& node,
 
 default_peer_ptr default_protocol::get_peer(const process_information& n) {
     CPPA_LOG_TRACE("n = " << to_string(n));
-    auto i = m_peers.find(n);
-    if (i != m_peers.end()) {
+    auto& peers = m_peers[loop_of(n)];
+    auto i = peers.find(n);
+    if (i != peers.end()) {
         CPPA_LOG_DEBUG("result = " << i->second.impl.get());
         return i->second.impl;
     }
@@ -140,18 +227,20 @@ default_peer_ptr default_protocol::get_peer(const process_information& n) {
 
 void default_protocol::enqueue(const process_information& node,
                                const message_header& hdr,
-                               any_tuple msg) {
-    auto& entry = m_peers[node];
+                               any_tuple msg,
+                               serialized_payload_ptr payload) {
+    auto& entry = m_peers[loop_of(node)][node];
     if (entry.impl) {
         CPPA_REQUIRE(entry.queue != nullptr);
-        if (!entry.impl->has_unwritten_data()) {
-            CPPA_REQUIRE(entry.queue->empty());
-            entry.impl->enqueue(hdr, msg);
+        // append to the peer's write buffer unless it is
+        // unable to write fast enough already
+        if (entry.queue->empty() && !entry.impl->write_buffer_full()) {
+            entry.impl->enqueue(hdr, msg, payload);
             return;
         }
     }
     if (entry.queue == nullptr) entry.queue.emplace();
-    entry.queue->emplace(hdr, msg);
+    entry.queue->emplace(hdr, move(msg), move(payload));
 }
 
 
@@ -196,7 +285,7 @@ actor_ptr default_protocol::remote_actor(io_stream_ptr_pair io,
     }
     default_protocol_ptr proto = this;
     intrusive::single_reader_queue<remote_actor_result> q;
-    run_later([proto, io, pinfptr, remote_aid, &q] {
+    run_later(loop_of(*pinfptr), [proto, io, pinfptr, remote_aid, &q] {
         CPPA_LOGF_TRACE("lambda from default_protocol::remote_actor");
         auto pp = proto->get_peer(*pinfptr);
         CPPA_LOGF_INFO_IF(pp, "connection already exists (re-use old one)");
@@ -215,23 +304,47 @@ void default_protocol::last_proxy_exited(const default_peer_ptr& pptr) {
                    << ", pptr->node() = " << to_string(pptr->node()));
     if (pptr->erase_on_last_proxy_exited() && pptr->queue().empty()) {
         stop_reader(pptr.get());
-        auto i = m_peers.find(pptr->node());
-        if (i != m_peers.end()) {
+        auto& peers = m_peers[loop_of(pptr->node())];
+        auto i = peers.find(pptr->node());
+        if (i != peers.end()) {
             CPPA_LOG_DEBUG_IF(i->second.impl != pptr,
                               "node " << to_string(pptr->node())
                               << " does not exist in m_peers");
             if (i->second.impl == pptr) {
-                m_peers.erase(i);
+                peers.erase(i);
             }
         }
     }
 }
 
+void default_protocol::migrate(const default_peer_ptr& pptr) {
+    CPPA_LOG_TRACE("pptr = " << pptr.get()
+                   << ", pptr->node() = " << to_string(pptr->node()));
+    auto loop = loop_of(pptr->node());
+    stop_reader(pptr.get());
+    // this loop no longer accesses pptr once its reader was removed
+    pptr->loop_id(loop);
+    default_protocol_ptr proto = this;
+    run_later(loop, [proto, pptr] {
+        CPPA_LOGF_TRACE("lambda from default_protocol::migrate");
+        proto->continue_reader(pptr.get());
+        proto->register_peer(pptr->node(), pptr.get());
+        if (pptr->resume_reading() == read_failure) {
+            proto->stop_reader(pptr.get());
+        }
+    });
+}
+
 void default_protocol::new_peer(const input_stream_ptr& in,
                                 const output_stream_ptr& out,
-                                const process_information_ptr& node) {
+                                const process_information_ptr& node,
+                                std::uint32_t offered_features) {
     CPPA_LOG_TRACE("");
-    auto ptr = make_counted<default_peer>(this, in, out, node);
+    auto ptr = make_counted<default_peer>(this, in, out, node,
+                                          offered_features);
+    // outgoing connections are created in the event loop of their node,
+    // incoming connections start in the event loop of their acceptor
+    if (node) ptr->loop_id(loop_of(*node));
     continue_reader(ptr.get());
     if (node) register_peer(*node, ptr.get());
 }
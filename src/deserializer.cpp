@@ -33,16 +33,44 @@
 #include "cppa/object.hpp"
 #include "cppa/deserializer.hpp"
 #include "cppa/uniform_type_info.hpp"
+
+#include "cppa/util/pt_token.hpp"
+#include "cppa/util/pt_dispatch.hpp"
+
+#include "cppa/detail/ptype_to_type.hpp"
 #include "cppa/detail/to_uniform_name.hpp"
 
 namespace cppa {
 
+namespace {
+
+struct array_reader {
+
+    deserializer* source;
+    size_t num;
+    void* storage;
+
+    template<primitive_type PT>
+    void operator()(util::pt_token<PT>) const {
+        typedef typename detail::ptype_to_type<PT>::type value_type;
+        auto i = reinterpret_cast<value_type*>(storage);
+        for (auto e = i + num; i != e; ++i) *i = source->read<value_type>();
+    }
+
+};
+
+} // namespace <anonymous>
+
 deserializer::deserializer(actor_addressing* aa) : m_addressing(aa) { }
 
 deserializer::~deserializer() { }
 
+void deserializer::read_array(primitive_type ptype, size_t num, void* storage) {
+    util::pt_dispatch(ptype, array_reader{this, num, storage});
+}
+
 deserializer& operator>>(deserializer& d, object& what) {
-    std::string tname = d.peek_object();
+    auto& tname = d.peek_object();
     auto mtype = uniform_type_info::from(tname);
     if (mtype == nullptr) {
         throw std::logic_error("no uniform type info found for " + tname);
@@ -38,16 +38,18 @@ namespace cppa {
 
 event_based_actor::event_based_actor() : super(super::blocked) { }
 
+// receive() must not return into the handler of an event-based actor,
+// thus these use the throwing quit() of the base class
 void event_based_actor::dequeue(behavior&) {
-    quit(exit_reason::unallowed_function_call);
+    super::quit(exit_reason::unallowed_function_call);
 }
 
 void event_based_actor::dequeue(partial_function&) {
-    quit(exit_reason::unallowed_function_call);
+    super::quit(exit_reason::unallowed_function_call);
 }
 
 void event_based_actor::dequeue_response(behavior&, message_id_t) {
-    quit(exit_reason::unallowed_function_call);
+    super::quit(exit_reason::unallowed_function_call);
 }
 
 resume_result event_based_actor::resume(util::fiber*) {
@@ -111,13 +113,10 @@ void event_based_actor::become_waiting_for(behavior&& bhvr, message_id_t mf) {
 }
 
 void event_based_actor::quit(std::uint32_t reason) {
-    if (reason == exit_reason::normal) {
-        cleanup(exit_reason::normal);
-        m_bhvr_stack.clear();
-    }
-    else {
-        abstract_scheduled_actor::quit(reason);
-    }
+    // does not throw: an empty behavior stack causes resume() to return
+    // after the currently invoked handler (if any) has finished
+    cleanup(reason);
+    m_bhvr_stack.clear();
 }
 
 void event_based_actor::unbecome() {
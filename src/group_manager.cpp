@@ -45,6 +45,7 @@
 #include "cppa/detail/types_array.hpp"
 #include "cppa/detail/group_manager.hpp"
 #include "cppa/network/message_header.hpp"
+#include "cppa/network/serialized_payload.hpp"
 
 #include "cppa/util/shared_spinlock.hpp"
 #include "cppa/util/shared_lock_guard.hpp"
@@ -68,6 +69,8 @@ class local_group : public group {
 
     void send_all_subscribers(actor* sender, const any_tuple& msg) {
         shared_guard guard(m_mtx);
+        // remote subscribers share the serialized message
+        network::serialized_payload::fan_out_scope scope;
         for (auto& s : m_subscribers) {
             s->enqueue(sender, msg);
         }
@@ -160,6 +163,7 @@ class local_broker : public event_based_actor {
     void send_to_acquaintances(const any_tuple& what) {
         // send to all remote subscribers
         auto sender = last_sender().get();
+        network::serialized_payload::fan_out_scope scope;
         for (auto& acquaintance : m_acquaintances) {
             acquaintance->enqueue(sender, what);
         }
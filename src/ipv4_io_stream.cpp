@@ -42,6 +42,7 @@
 #else
 #   include <netdb.h>
 #   include <unistd.h>
+#   include <sys/uio.h>
 #   include <sys/types.h>
 #   include <sys/socket.h>
 #   include <netinet/in.h>
@@ -112,7 +113,21 @@ void ipv4_io_stream::write(const void* vbuf, size_t len) {
 size_t ipv4_io_stream::write_some(const void* buf, size_t len) {
     auto send_result = ::send(m_fd, buf, len, 0);
     handle_write_result(send_result, true);
-    return static_cast<size_t>(send_result);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
+}
+
+size_t ipv4_io_stream::write_some(const output_slice* slices,
+                                  size_t num_slices) {
+    static constexpr size_t max_slices = 64;
+    iovec iov[max_slices];
+    if (num_slices > max_slices) num_slices = max_slices;
+    for (size_t i = 0; i < num_slices; ++i) {
+        iov[i].iov_base = const_cast<void*>(slices[i].data);
+        iov[i].iov_len = slices[i].size;
+    }
+    auto send_result = ::writev(m_fd, iov, static_cast<int>(num_slices));
+    handle_write_result(send_result, true);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
 }
 
 network::io_stream_ptr ipv4_io_stream::from_native_socket(native_socket_type fd) {
@@ -0,0 +1,102 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <mutex>
+#include <exception>
+
+#include "cppa/logging.hpp"
+#include "cppa/binary_deserializer.hpp"
+
+#include "cppa/detail/demangle.hpp"
+#include "cppa/detail/lazy_tuple.hpp"
+
+namespace cppa { namespace detail {
+
+lazy_tuple::lazy_tuple(util::blob data,
+                       std::uint32_t format,
+                       std::shared_ptr<type_lookup_table> types)
+: super(tuple_impl_info::dynamically_typed), m_data(std::move(data))
+, m_format(format), m_types(std::move(types)), m_ready(false) { }
+
+void lazy_tuple::materialize() const {
+    std::lock_guard<util::shared_spinlock> guard(m_mtx);
+    if (m_ready.load(std::memory_order_relaxed)) return;
+    // no addressing, i.e., reading an actor_ptr throws
+    binary_deserializer bd(m_data.begin(), m_data.end(),
+                           nullptr, m_types.get());
+    bd.format(m_format);
+    bd.data_owner(m_data.owner());
+    try { uniform_typeid<any_tuple>()->deserialize(&m_tuple, &bd); }
+    catch (std::exception& e) {
+        CPPA_LOG_ERROR("cannot deserialize lazy_tuple: "
+                       << detail::demangle(typeid(e))
+                       << ", what(): " << e.what());
+        static_cast<void>(e); // keep compiler happy
+        m_tuple = any_tuple{};
+    }
+    // release the data as early as possible
+    m_data = util::blob{};
+    m_types.reset();
+    m_ready.store(true, std::memory_order_release);
+}
+
+const abstract_tuple& lazy_tuple::get() const {
+    if (!m_ready.load(std::memory_order_acquire)) materialize();
+    return *m_tuple.cvals();
+}
+
+void* lazy_tuple::mutable_at(size_t pos) {
+    get();
+    // m_tuple is not shared, i.e., this does not copy any data
+    return m_tuple.vals()->mutable_at(pos);
+}
+
+size_t lazy_tuple::size() const {
+    return get().size();
+}
+
+abstract_tuple* lazy_tuple::copy() const {
+    return get().copy();
+}
+
+const void* lazy_tuple::at(size_t pos) const {
+    return get().at(pos);
+}
+
+const uniform_type_info* lazy_tuple::type_at(size_t pos) const {
+    return get().type_at(pos);
+}
+
+const void* lazy_tuple::signature_token() const {
+    return get().signature_token();
+}
+
+} } // namespace cppa::detail
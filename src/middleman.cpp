@@ -32,6 +32,7 @@
 #include <cerrno>
 #include <memory>
 #include <cstring>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
@@ -60,6 +61,7 @@
 
 #include "cppa/detail/fd_util.hpp"
 #include "cppa/detail/actor_registry.hpp"
+#include "cppa/detail/singleton_manager.hpp"
 
 #include "cppa/intrusive/single_reader_queue.hpp"
 
@@ -75,6 +77,22 @@
 #   include <poll.h>
 #endif
 
+#ifdef CPPA_LINUX
+#   include <sys/eventfd.h>
+#endif
+
+// io_uring is an opt-in alternative to epoll_wait/epoll_ctl
+#if defined(CPPA_EPOLL_IMPL) && defined(CPPA_IO_URING)
+#   define CPPA_URING_IMPL
+#   include <map>
+#   include <poll.h>
+#   include <unistd.h>
+#   include <sys/uio.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <linux/io_uring.h>
+#endif
+
 using namespace std;
 
 namespace cppa { namespace network {
@@ -109,6 +127,10 @@ struct pfd_access {
         return i.second->ptr.get();
     }
 
+    inline continue_reading_result continue_reading(pfd_iterator& i) const {
+        return ptr(i)->continue_reading();
+    }
+
     inline bool equal(const pfd_iterator& lhs, const pfd_iterator& rhs) const {
         return lhs.first == rhs.first;
     }
@@ -230,6 +252,22 @@ class middleman_event_handler : public middleman_event_handler_base<middleman_ev
 
 #elif defined(CPPA_EPOLL_IMPL)
 
+#ifdef CPPA_URING_IMPL
+
+// a read or accept the event loop performed on behalf of a
+// reader, see continuable_reader::completion()
+struct io_completion {
+    continuable_reader* ptr;
+    completion_mode mode;
+    int result;
+};
+
+// marks events referring to an io_completion; epoll_wait never
+// sets this flag, since no file descriptor uses one-shot mode
+constexpr uint32_t io_completion_flag = EPOLLONESHOT;
+
+#endif // CPPA_URING_IMPL
+
 struct epoll_iterator_access {
 
     typedef vector<epoll_event>::iterator iterator;
@@ -247,9 +285,27 @@ struct epoll_iterator_access {
     }
 
     inline continuable_reader* ptr(iterator& i) const {
+#       ifdef CPPA_URING_IMPL
+        if (i->events & io_completion_flag) {
+            return reinterpret_cast<io_completion*>(i->data.ptr)->ptr;
+        }
+#       endif
         return reinterpret_cast<continuable_reader*>(i->data.ptr);
     }
 
+    inline continue_reading_result continue_reading(iterator& i) const {
+#       ifdef CPPA_URING_IMPL
+        if (i->events & io_completion_flag) {
+            auto c = reinterpret_cast<io_completion*>(i->data.ptr);
+            if (c->mode == completion_mode::accept) {
+                return c->ptr->accepted(c->result);
+            }
+            return c->ptr->read_completed(static_cast<size_t>(c->result));
+        }
+#       endif
+        return ptr(i)->continue_reading();
+    }
+
     inline bool equal(const iterator& lhs, const iterator& rhs) const {
         return lhs == rhs;
     }
@@ -261,6 +317,437 @@ struct epoll_iterator_access {
 typedef event_iterator_impl<vector<epoll_event>::iterator,epoll_iterator_access>
         event_iterator;
 
+#ifdef CPPA_URING_IMPL
+
+// maximum number of read buffers registered with the kernel per loop
+constexpr unsigned max_registered_buffers = 256;
+
+// completion-based I/O using io_uring: the event loop reads into the
+// buffers of readers supporting completion_mode::read, using registered
+// buffers if possible, and accepts connections for readers supporting
+// completion_mode::accept, using a single multishot request if possible;
+// other readers and all writers get readiness events from single-shot
+// poll requests, which are armed again after their event was handled to
+// keep the level-triggered semantics of epoll; all requests are submitted
+// together with the next wait using a single system call
+class uring_poller {
+
+ public:
+
+    uring_poller() : m_fd(-1), m_sq_ring(MAP_FAILED), m_cq_ring(MAP_FAILED)
+                   , m_sqes(MAP_FAILED), m_sq_tail(0), m_to_submit(0)
+                   , m_generation(0), m_completions(false)
+                   , m_register_buffers(false), m_multishot_accept(true) { }
+
+    ~uring_poller() {
+        if (m_fd != -1) {
+            // the kernel writes to the buffers of pending reads
+            // until they complete, thus wait for all of them
+            for (size_t fd = 0; fd < m_entries.size(); ++fd) {
+                auto& e = m_entries[fd];
+                if (e.io_generation != 0) {
+                    cancel_io(static_cast<native_socket_type>(fd), e);
+                }
+            }
+            vector<epoll_event> dummy;
+            while (!m_detached.empty()) {
+                enter(1);
+                reap(dummy);
+                dummy.clear();
+            }
+        }
+        if (m_sqes != MAP_FAILED) {
+            munmap(m_sqes, m_sq_entries * sizeof(io_uring_sqe));
+        }
+        if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring) {
+            munmap(m_cq_ring, m_cq_ring_size);
+        }
+        if (m_sq_ring != MAP_FAILED) munmap(m_sq_ring, m_sq_ring_size);
+        if (m_fd != -1) close(m_fd);
+    }
+
+    // returns false if the kernel does not support io_uring
+    bool init(unsigned entries) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(io_uring_params));
+        auto fd = syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) return false;
+        m_fd = static_cast<int>(fd);
+        m_sq_entries = params.sq_entries;
+        m_sq_ring_size =   params.sq_off.array
+                         + params.sq_entries * sizeof(unsigned);
+        m_cq_ring_size =   params.cq_off.cqes
+                         + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            m_sq_ring_size = max(m_sq_ring_size, m_cq_ring_size);
+        }
+        m_sq_ring = mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        if (m_sq_ring == MAP_FAILED) return false;
+        if (single_mmap) m_cq_ring = m_sq_ring;
+        else {
+            m_cq_ring = mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, m_fd,
+                             IORING_OFF_CQ_RING);
+            if (m_cq_ring == MAP_FAILED) return false;
+        }
+        m_sqes = mmap(nullptr, m_sq_entries * sizeof(io_uring_sqe),
+                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      m_fd, IORING_OFF_SQES);
+        if (m_sqes == MAP_FAILED) return false;
+        auto sq = reinterpret_cast<char*>(m_sq_ring);
+        m_sq_khead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sq_ktail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sq_tail = *m_sq_ktail;
+        auto cq = reinterpret_cast<char*>(m_cq_ring);
+        m_cq_khead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_ktail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        // events point to the completions of one reap() call
+        m_completed.reserve(params.cq_entries);
+        // without fast poll, reads on idle sockets would block
+        // kernel worker threads rather than waiting for data
+        m_completions = (params.features & IORING_FEAT_FAST_POLL) != 0;
+        // registers an empty buffer table, filled per reader
+        io_uring_rsrc_register reg;
+        memset(&reg, 0, sizeof(io_uring_rsrc_register));
+        reg.nr = max_registered_buffers;
+        reg.flags = IORING_RSRC_REGISTER_SPARSE;
+        if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS2,
+                    &reg, sizeof(io_uring_rsrc_register)) == 0) {
+            m_register_buffers = true;
+            for (unsigned i = max_registered_buffers; i > 0; --i) {
+                m_free_buffers.push_back(static_cast<int>(i - 1));
+            }
+        }
+        CPPA_LOG_INFO_IF(!m_completions, "io_uring without fast poll, "
+                                         "use readiness events only");
+        CPPA_LOG_INFO_IF(!m_register_buffers, "io_uring does not support "
+                                              "sparse buffer registration");
+        return true;
+    }
+
+    void update(native_socket_type fd, event_bitmask mask,
+                continuable_reader* ptr) {
+        auto index = static_cast<size_t>(fd);
+        if (index >= m_entries.size()) m_entries.resize(index + 1);
+        auto& e = m_entries[index];
+        if (e.poll_generation != 0) {
+            auto sqe = next_sqe();
+            sqe->opcode = IORING_OP_POLL_REMOVE;
+            sqe->fd = -1;
+            sqe->addr = key(fd, e.poll_generation);
+            sqe->user_data = 0;
+            e.poll_generation = 0;
+        }
+        auto mode = completion_mode::none;
+        if (m_completions && (mask & event::read)) mode = ptr->completion();
+        // a pending read or accept remains valid as long as
+        // its reader remains registered for reading
+        if (e.io_generation != 0 && (e.ptr != ptr || e.mode != mode)) {
+            cancel_io(fd, e);
+        }
+        if (mode != completion_mode::read) release_buffer(e);
+        e.mask = mask;
+        e.mode = mode;
+        e.ptr = ptr;
+        if (mask != event::none) arm(fd, e);
+    }
+
+    // waits for at least one event and stores all events in @p storage
+    void poll(vector<epoll_event>& storage) {
+        for (auto fd : m_rearm) {
+            auto& e = m_entries[static_cast<size_t>(fd)];
+            if (e.mask != event::none) arm(fd, e);
+        }
+        m_rearm.clear();
+        storage.clear();
+        m_completed.clear();
+        while (storage.empty()) {
+            enter(1);
+            reap(storage);
+        }
+    }
+
+ private:
+
+    struct entry {
+        continuable_reader* ptr;
+        event_bitmask mask;
+        completion_mode mode;
+        // identifies the armed poll request or 0 if none
+        uint32_t poll_generation;
+        // identifies the pending read or accept or 0 if none
+        uint32_t io_generation;
+        // keeps the buffer of the pending read alive
+        continuable_reader_ptr io_owner;
+        // index and memory of the registered buffer or -1
+        int buf_index;
+        const char* buf_data;
+        size_t buf_size;
+        entry() : ptr(nullptr), mask(event::none)
+                , mode(completion_mode::none), poll_generation(0)
+                , io_generation(0), buf_index(-1), buf_data(nullptr)
+                , buf_size(0) { }
+    };
+
+    // a read or accept of a reader that is no longer registered
+    struct detached_io {
+        continuable_reader_ptr owner;
+        completion_mode mode;
+    };
+
+    static inline uint64_t key(native_socket_type fd, uint32_t generation) {
+        return (static_cast<uint64_t>(fd) << 32) | generation;
+    }
+
+    uint32_t next_generation() {
+        if (++m_generation == 0) ++m_generation; // 0 denotes 'not armed'
+        return m_generation;
+    }
+
+    io_uring_sqe* next_sqe() {
+        auto head = __atomic_load_n(m_sq_khead, __ATOMIC_ACQUIRE);
+        if (m_sq_tail - head == m_sq_entries) enter(0);
+        auto index = m_sq_tail & m_sq_mask;
+        auto sqe = reinterpret_cast<io_uring_sqe*>(m_sqes) + index;
+        memset(sqe, 0, sizeof(io_uring_sqe));
+        m_sq_array[index] = index;
+        ++m_sq_tail;
+        ++m_to_submit;
+        return sqe;
+    }
+
+    // submits the requests @p e is missing
+    void arm(native_socket_type fd, entry& e) {
+        uint32_t events = 0;
+        if ((e.mask & event::read) && e.mode == completion_mode::none) {
+            events |= POLLIN | POLLRDHUP;
+        }
+        if (e.mask & event::write) events |= POLLOUT;
+        if (events != 0 && e.poll_generation == 0) {
+            e.poll_generation = next_generation();
+            auto sqe = next_sqe();
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = fd;
+            sqe->poll32_events = events;
+            sqe->user_data = key(fd, e.poll_generation);
+        }
+        if (e.mode != completion_mode::none && e.io_generation == 0) {
+            e.io_generation = next_generation();
+            e.io_owner = e.ptr;
+            auto sqe = next_sqe();
+            sqe->fd = fd;
+            sqe->user_data = key(fd, e.io_generation);
+            if (e.mode == completion_mode::accept) {
+                sqe->opcode = IORING_OP_ACCEPT;
+                if (m_multishot_accept) sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+            }
+            else {
+                auto buf = e.ptr->read_buffer();
+                CPPA_REQUIRE(buf != nullptr && buf->remaining() > 0);
+                auto buf_index = registered_buffer(e, *buf);
+                if (buf_index >= 0) {
+                    sqe->opcode = IORING_OP_READ_FIXED;
+                    sqe->buf_index = static_cast<uint16_t>(buf_index);
+                }
+                else sqe->opcode = IORING_OP_RECV;
+                sqe->addr = reinterpret_cast<uint64_t>(buf->data() + buf->size());
+                sqe->len = static_cast<uint32_t>(buf->remaining());
+            }
+        }
+    }
+
+    void cancel_io(native_socket_type fd, entry& e) {
+        auto k = key(fd, e.io_generation);
+        auto sqe = next_sqe();
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = k;
+        sqe->user_data = 0;
+        m_detached.insert(make_pair(k, detached_io{move(e.io_owner), e.mode}));
+        e.io_generation = 0;
+    }
+
+    // returns the index of a registered buffer covering @p buf or -1
+    int registered_buffer(entry& e, util::buffer& buf) {
+        if (e.buf_index < 0) {
+            if (m_free_buffers.empty()) return -1;
+            e.buf_index = m_free_buffers.back();
+            m_free_buffers.pop_back();
+            e.buf_data = nullptr;
+        }
+        // readers replace or grow their buffer only occasionally
+        if (e.buf_data != buf.data() || e.buf_size != buf.final_size()) {
+            iovec iov;
+            iov.iov_base = buf.data();
+            iov.iov_len = buf.final_size();
+            uint64_t tag = 0;
+            io_uring_rsrc_update2 upd;
+            memset(&upd, 0, sizeof(io_uring_rsrc_update2));
+            upd.offset = static_cast<uint32_t>(e.buf_index);
+            upd.data = reinterpret_cast<uint64_t>(&iov);
+            upd.tags = reinterpret_cast<uint64_t>(&tag);
+            upd.nr = 1;
+            if (syscall(__NR_io_uring_register, m_fd,
+                        IORING_REGISTER_BUFFERS_UPDATE,
+                        &upd, sizeof(io_uring_rsrc_update2)) < 0) {
+                // e.g., RLIMIT_MEMLOCK exceeded; use plain recv from now on
+                CPPA_LOG_INFO("cannot register buffer: " << strerror(errno));
+                m_register_buffers = false;
+                m_free_buffers.clear();
+                e.buf_index = -1;
+                return -1;
+            }
+            e.buf_data = buf.data();
+            e.buf_size = buf.final_size();
+        }
+        return e.buf_index;
+    }
+
+    // the kernel keeps the memory of a released buffer
+    // pinned until its index is registered again
+    void release_buffer(entry& e) {
+        if (e.buf_index >= 0 && m_register_buffers) {
+            m_free_buffers.push_back(e.buf_index);
+        }
+        e.buf_index = -1;
+    }
+
+    // submits all pending requests and waits for min_complete events
+    void enter(unsigned min_complete) {
+        __atomic_store_n(m_sq_ktail, m_sq_tail, __ATOMIC_RELEASE);
+        unsigned flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+        auto res = syscall(__NR_io_uring_enter, m_fd, m_to_submit,
+                           min_complete, flags, nullptr, 0);
+        if (res >= 0) {
+            m_to_submit -= static_cast<unsigned>(res);
+            return;
+        }
+        switch (errno) {
+            // a signal was caught
+            case EINTR:
+            // completion queue is full; caller must reap events first
+            case EAGAIN:
+            case EBUSY:
+                break;
+            default: {
+                perror("io_uring_enter() failed");
+                CPPA_CRITICAL("io_uring_enter() failed");
+            }
+        }
+    }
+
+    void reap(vector<epoll_event>& storage) {
+        auto head = *m_cq_khead;
+        auto tail = __atomic_load_n(m_cq_ktail, __ATOMIC_ACQUIRE);
+        // events point into m_completed, which must not grow
+        for (; head != tail && m_completed.size() < m_completed.capacity();
+             ++head) {
+            auto& cqe = m_cqes[head & m_cq_mask];
+            // completion of a removal or cancellation
+            if (cqe.user_data == 0) continue;
+            bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+            auto d = m_detached.find(cqe.user_data);
+            if (d != m_detached.end()) {
+                if (d->second.mode == completion_mode::accept && cqe.res >= 0) {
+                    closesocket(cqe.res);
+                }
+                if (!more) m_detached.erase(d);
+                continue;
+            }
+            auto fd = static_cast<native_socket_type>(cqe.user_data >> 32);
+            auto generation = static_cast<uint32_t>(cqe.user_data);
+            auto& e = m_entries[static_cast<size_t>(fd)];
+            epoll_event ev;
+            if (generation == e.poll_generation) {
+                e.poll_generation = 0;
+                m_rearm.push_back(fd);
+                ev.events = (cqe.res < 0) ? static_cast<uint32_t>(EPOLLERR)
+                                          : static_cast<uint32_t>(cqe.res);
+                ev.data.ptr = e.ptr;
+                storage.push_back(ev);
+            }
+            else if (generation == e.io_generation) {
+                if (!more) {
+                    e.io_generation = 0;
+                    e.io_owner.reset();
+                    m_rearm.push_back(fd);
+                }
+                if (cqe.res >= 0) {
+                    m_completed.push_back(io_completion{e.ptr, e.mode, cqe.res});
+                    ev.events = EPOLLIN | io_completion_flag;
+                    ev.data.ptr = &m_completed.back();
+                    storage.push_back(ev);
+                    continue;
+                }
+                // kernel does not support multishot accept
+                if (   cqe.res == -EINVAL
+                    && e.mode == completion_mode::accept
+                    && m_multishot_accept) {
+                    m_multishot_accept = false;
+                    continue;
+                }
+                switch (-cqe.res) {
+                    // no data or connection available or request
+                    // cancelled by the kernel; try again
+                    case EAGAIN:
+                    case EINTR:
+                    case ECANCELED:
+                        break;
+                    default:
+                        ev.events = EPOLLERR;
+                        ev.data.ptr = e.ptr;
+                        storage.push_back(ev);
+                }
+            }
+            // else: request was removed or replaced in the meantime
+        }
+        __atomic_store_n(m_cq_khead, head, __ATOMIC_RELEASE);
+    }
+
+    int m_fd;
+    void* m_sq_ring;
+    void* m_cq_ring;
+    void* m_sqes;
+    size_t m_sq_ring_size;
+    size_t m_cq_ring_size;
+    unsigned m_sq_entries;
+    unsigned* m_sq_khead;
+    unsigned* m_sq_ktail;
+    unsigned m_sq_mask;
+    unsigned* m_sq_array;
+    unsigned* m_cq_khead;
+    unsigned* m_cq_ktail;
+    unsigned m_cq_mask;
+    io_uring_cqe* m_cqes;
+    // tail of the submission queue, published by enter()
+    unsigned m_sq_tail;
+    unsigned m_to_submit;
+    uint32_t m_generation;
+    // kernel features
+    bool m_completions;
+    bool m_register_buffers;
+    bool m_multishot_accept;
+    // indexed by file descriptor
+    vector<entry> m_entries;
+    // file descriptors of the last events, armed again in poll()
+    vector<native_socket_type> m_rearm;
+    // reads and accepts performed by the last call to poll()
+    vector<io_completion> m_completed;
+    // pending requests of removed readers, indexed by user data
+    map<uint64_t, detached_io> m_detached;
+    // indices of unused registered buffers
+    vector<int> m_free_buffers;
+
+};
+
+#endif // CPPA_URING_IMPL
+
 class middleman_event_handler : public middleman_event_handler_base<middleman_event_handler> {
 
  public:
@@ -270,6 +757,11 @@ class middleman_event_handler : public middleman_event_handler_base<middleman_ev
     ~middleman_event_handler() { if (m_epollfd != -1) close(m_epollfd); }
 
     void init() {
+#       ifdef CPPA_URING_IMPL
+        m_use_uring = m_uring.init(256);
+        CPPA_LOG_INFO_IF(!m_use_uring, "io_uring not available, use epoll");
+        if (m_use_uring) return;
+#       endif
         m_epollfd = epoll_create1(EPOLL_CLOEXEC);
         if (m_epollfd == -1) throw ios_base::failure(  string("epoll_create1: ")
                                                      + strerror(errno));
@@ -281,6 +773,12 @@ class middleman_event_handler : public middleman_event_handler_base<middleman_ev
 
     pair<event_iterator,event_iterator> poll() {
         CPPA_REQUIRE(m_meta.empty() == false);
+#       ifdef CPPA_URING_IMPL
+        if (m_use_uring) {
+            m_uring.poll(m_events);
+            return {begin(m_events), end(m_events)};
+        }
+#       endif
         for (;;) {
             CPPA_LOG_DEBUG("epoll_wait on " << num_sockets() << " sockets");
             auto presult = epoll_wait(m_epollfd, m_events.data(),
@@ -334,6 +832,12 @@ class middleman_event_handler : public middleman_event_handler_base<middleman_ev
                 break;
             default: CPPA_CRITICAL("invalid event bitmask");
         }
+#       ifdef CPPA_URING_IMPL
+        if (m_use_uring) {
+            m_uring.update(fd, new_bitmask, ptr);
+            return;
+        }
+#       endif
         switch (me) {
             case fd_meta_event::add:
                 operation = EPOLL_CTL_ADD;
@@ -374,38 +878,143 @@ class middleman_event_handler : public middleman_event_handler_base<middleman_ev
     int m_epollfd;
     vector<epoll_event> m_events;
 
+#   ifdef CPPA_URING_IMPL
+    bool m_use_uring = false;
+    uring_poller m_uring;
+#   endif
+
 };
 
 #endif
 
-class middleman_event {
-
-    friend class intrusive::single_reader_queue<middleman_event>;
+class functor_event : public middleman_event {
 
  public:
 
-    template<typename Arg>
-    middleman_event(Arg&& arg) : next(0), fun(forward<Arg>(arg)) { }
+    functor_event(function<void()> fun) : m_fun(move(fun)) { }
 
-    inline void operator()() { fun(); }
+    void run() { m_fun(); }
 
  private:
 
-    middleman_event* next;
-    function<void()> fun;
+    function<void()> m_fun;
 
 };
 
 typedef intrusive::single_reader_queue<middleman_event> middleman_queue;
 
+// maximum number of events handled before polling sockets again
+constexpr size_t max_events_per_wakeup = 512;
+
+class event_loop;
+
+void middleman_loop(event_loop*);
+
+// an event loop running in its own thread, multiplexing the sockets
+// assigned to it and executing the events enqueued via run_later
+class event_loop {
+
+    friend class middleman_overseer;
+    friend void middleman_loop(event_loop*);
+
+ public:
+
+    event_loop(size_t id) : m_id(id), m_done(false) { }
+
+    inline size_t id() const { return m_id; }
+
+    void run_later(middleman_event* what) {
+        CPPA_LOG_TRACE("");
+        // the loop drains the whole queue on each wakeup,
+        // thus only the first event needs to wake it up
+        if (m_queue._push_back(what)) wake_up();
+    }
+
+    void wake_up() {
+#       ifdef CPPA_LINUX
+        uint64_t one = 1;
+        if (write(m_pipe_write, &one, sizeof(one)) != sizeof(one)) {
+#       else
+        uint8_t dummy = 0;
+        if (write(m_pipe_write, &dummy, sizeof(dummy)) != sizeof(dummy)) {
+#       endif
+            // already exited?
+            CPPA_LOG_WARNING("cannot signal middleman");
+        }
+    }
+
+    void start() {
+#       ifdef CPPA_LINUX
+        m_pipe_read = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_pipe_read < 0) { CPPA_CRITICAL("cannot create eventfd"); }
+        m_pipe_write = m_pipe_read;
+#       else
+        int pipefds[2];
+        if (pipe(pipefds) != 0) { CPPA_CRITICAL("cannot create pipe"); }
+        m_pipe_read = pipefds[0];
+        m_pipe_write = pipefds[1];
+        detail::fd_util::nonblocking(m_pipe_read, true);
+#       endif
+        m_thread = thread([this] { middleman_loop(this); });
+    }
+
+    void quit() {
+        run_later(new functor_event([this] {
+            CPPA_LOG_TRACE("lambda from event_loop::quit");
+            this->m_done = true;
+        }));
+    }
+
+    void join() {
+        m_thread.join();
+        close(m_pipe_read);
+        if (m_pipe_write != m_pipe_read) close(m_pipe_write);
+    }
+
+    void continue_writer(const continuable_reader_ptr& ptr) {
+        m_handler.add(ptr, event::write);
+    }
+
+    void stop_writer(const continuable_reader_ptr& ptr) {
+        m_handler.erase(ptr, event::write);
+    }
+
+    void continue_reader(const continuable_reader_ptr& ptr) {
+        m_readers.push_back(ptr);
+        m_handler.add(ptr, event::read);
+    }
+
+    void stop_reader(const continuable_reader_ptr& ptr) {
+        m_handler.erase(ptr, event::read);
+        auto last = end(m_readers);
+        auto i = find(begin(m_readers), last, ptr);
+        if (i != last) m_readers.erase(i);
+    }
+
+ private:
+
+    size_t m_id;
+    bool m_done;
+    thread m_thread;
+    native_socket_type m_pipe_read;
+    native_socket_type m_pipe_write;
+    middleman_queue m_queue;
+    middleman_event_handler m_handler;
+    vector<continuable_reader_ptr> m_readers;
+
+};
+
 class middleman_impl : public abstract_middleman {
 
     friend class abstract_middleman;
-    friend void middleman_loop(middleman_impl*);
 
  public:
 
-    middleman_impl() {
+    middleman_impl(size_t num_loops = 1) {
+        CPPA_REQUIRE(num_loops > 0);
+        for (size_t i = 0; i < num_loops; ++i) {
+            m_loops.emplace_back(new event_loop(i));
+        }
         m_protocols.insert(make_pair(atom("DEFAULT"),
                                      new network::default_protocol(this)));
     }
@@ -427,39 +1036,39 @@ class middleman_impl : public abstract_middleman {
     }
 
     void run_later(function<void()> fun) {
-        CPPA_LOG_TRACE("");
-        m_queue._push_back(new middleman_event(move(fun)));
-        atomic_thread_fence(memory_order_seq_cst);
-        uint8_t dummy = 0;
-        if (write(m_pipe_write, &dummy, sizeof(dummy)) != sizeof(dummy)) {
-            // already exited?
-            CPPA_LOG_WARNING("cannot write to pipe");
-        }
+        run_later(0, new functor_event(move(fun)));
+    }
+
+    void run_later(middleman_event* what) {
+        run_later(0, what);
+    }
+
+    void run_later(size_t loop, function<void()> fun) {
+        run_later(loop, new functor_event(move(fun)));
+    }
+
+    void run_later(size_t loop, middleman_event* what) {
+        CPPA_REQUIRE(loop < m_loops.size());
+        m_loops[loop]->run_later(what);
+    }
+
+    size_t num_loops() const {
+        return m_loops.size();
     }
 
  protected:
 
     void initialize() {
-        int pipefds[2];
-        if (pipe(pipefds) != 0) { CPPA_CRITICAL("cannot create pipe"); }
-        m_pipe_read = pipefds[0];
-        m_pipe_write = pipefds[1];
-        detail::fd_util::nonblocking(m_pipe_read, true);
         // start threads
-        m_thread = thread([this] { middleman_loop(this); });
+        for (auto& loop : m_loops) loop->start();
         // increase reference count for singleton manager
         ref();
     }
 
     void destroy() {
-        run_later([this] {
-            CPPA_LOG_TRACE("lambda from middleman_impl::stop");
-            this->m_done = true;
-        });
-        //enqueue_message(middleman_message::create());
-        m_thread.join();
-        close(m_pipe_read);
-        close(m_pipe_write);
+        // all loops flush their connections in parallel
+        for (auto& loop : m_loops) loop->quit();
+        for (auto& loop : m_loops) loop->join();
         // decrease reference count for singleton manager
         deref();
         //delete this;
@@ -467,11 +1076,12 @@ class middleman_impl : public abstract_middleman {
 
  private:
 
-    thread m_thread;
-    native_socket_type m_pipe_read;
-    native_socket_type m_pipe_write;
-    middleman_queue m_queue;
-    middleman_event_handler m_handler;
+    inline event_loop& loop(const continuable_reader_ptr& ptr) {
+        CPPA_REQUIRE(ptr->loop_id() < m_loops.size());
+        return *m_loops[ptr->loop_id()];
+    }
+
+    vector<unique_ptr<event_loop>> m_loops;
 
     util::shared_spinlock m_protocols_lock;
     map<atom_value,protocol_ptr> m_protocols;
@@ -482,21 +1092,34 @@ middleman* middleman::create_singleton() {
     return new middleman_impl;
 }
 
+void set_default_middleman(size_t num_loops) {
+    if (num_loops == 0) {
+        throw std::invalid_argument("num_loops == 0");
+    }
+    auto ptr = new middleman_impl(num_loops);
+    if (detail::singleton_manager::set_middleman(ptr) == false) {
+        throw std::runtime_error("middleman already set");
+    }
+}
+
 class middleman_overseer : public continuable_reader {
 
     typedef continuable_reader super;
 
  public:
 
-    middleman_overseer(int pipe_fd, middleman_queue& q)
-    : super(pipe_fd), m_queue(q) { }
+    middleman_overseer(int pipe_fd, event_loop* parent)
+    : super(pipe_fd), m_parent(parent) {
+        loop_id(parent->id());
+    }
 
     continue_reading_result continue_reading() {
         CPPA_LOG_TRACE("");
+        // resets the eventfd counter or drains (some) pipe bytes;
+        // the queue itself tells us how many events are pending
         static constexpr size_t num_dummies = 64;
         uint8_t dummies[num_dummies];
         auto read_result = ::read(read_handle(), dummies, num_dummies);
-        CPPA_LOG_DEBUG("read " << read_result << " messages from queue");
         if (read_result < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
                 // try again later
@@ -507,16 +1130,19 @@ class middleman_overseer : public continuable_reader {
                 CPPA_CRITICAL("cannot read from pipe");
             }
         }
-        atomic_thread_fence(memory_order_seq_cst);
-        for (int i = 0; i < read_result; ++i) {
-            unique_ptr<middleman_event> msg(m_queue.try_pop());
-            if (!msg) {
-                CPPA_LOG_ERROR("nullptr dequeued");
-                CPPA_CRITICAL("nullptr dequeued");
-            }
+        auto& queue = m_parent->m_queue;
+        size_t i = 0;
+        for (; i < max_events_per_wakeup; ++i) {
+            auto ev = queue.try_pop();
+            if (!ev) break;
             CPPA_LOG_DEBUG("execute run_later functor");
-            (*msg)();
+            ev->run();
+            ev->dispose();
         }
+        CPPA_LOG_DEBUG("executed " << i << " events");
+        // give sockets a chance before handling the remaining events;
+        // producers see a non-empty queue and do not signal us again
+        if (i == max_events_per_wakeup && !queue.empty()) m_parent->wake_up();
         return read_continue_later;
     }
 
@@ -524,54 +1150,47 @@ class middleman_overseer : public continuable_reader {
 
  private:
 
-    middleman_queue& m_queue;
+    event_loop* m_parent;
 
 };
 
 middleman::~middleman() { }
 
-middleman_event_handler& abstract_middleman::handler() {
-    return static_cast<middleman_impl*>(this)->m_handler;
-}
+middleman_event::~middleman_event() { }
+
+void middleman_event::dispose() { delete this; }
 
 void abstract_middleman::continue_writer(const continuable_reader_ptr& ptr) {
     CPPA_LOG_TRACE("ptr = " << ptr.get());
     CPPA_REQUIRE(ptr->as_io() != nullptr);
-    handler().add(ptr, event::write);
+    static_cast<middleman_impl*>(this)->loop(ptr).continue_writer(ptr);
 }
 
 void abstract_middleman::stop_writer(const continuable_reader_ptr& ptr) {
     CPPA_LOG_TRACE("ptr = " << ptr.get());
     CPPA_REQUIRE(ptr->as_io() != nullptr);
-    handler().erase(ptr, event::write);
+    static_cast<middleman_impl*>(this)->loop(ptr).stop_writer(ptr);
 }
 
 void abstract_middleman::continue_reader(const continuable_reader_ptr& ptr) {
     CPPA_LOG_TRACE("ptr = " << ptr.get());
-    m_readers.push_back(ptr);
-    handler().add(ptr, event::read);
+    static_cast<middleman_impl*>(this)->loop(ptr).continue_reader(ptr);
 }
 
 void abstract_middleman::stop_reader(const continuable_reader_ptr& ptr) {
     CPPA_LOG_TRACE("ptr = " << ptr.get());
-    handler().erase(ptr, event::read);
-
-    auto last = end(m_readers);
-    auto i = find_if(begin(m_readers), last, [ptr](const continuable_reader_ptr& value) {
-        return value == ptr;
-    });
-    if (i != last) m_readers.erase(i);
+    static_cast<middleman_impl*>(this)->loop(ptr).stop_reader(ptr);
 }
 
-void middleman_loop(middleman_impl* impl) {
+void middleman_loop(event_loop* impl) {
     middleman_event_handler* handler = &impl->m_handler;
-    CPPA_LOGF_TRACE("run middleman loop");
-    CPPA_LOGF_INFO("middleman runs at "
+    CPPA_LOGF_TRACE("run middleman loop " << impl->id());
+    CPPA_LOGF_INFO("middleman loop " << impl->id() << " runs at "
                    << to_string(*process_information::get()));
     handler->init();
-    impl->continue_reader(make_counted<middleman_overseer>(impl->m_pipe_read, impl->m_queue));
+    impl->continue_reader(make_counted<middleman_overseer>(impl->m_pipe_read, impl));
     handler->update();
-    while (!impl->done()) {
+    while (!impl->m_done) {
         auto iters = handler->poll();
         for (auto i = iters.first; i != iters.second; ++i) {
             auto mask = i->type();
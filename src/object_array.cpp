@@ -28,19 +28,128 @@
 \******************************************************************************/
 
 
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
 #include "cppa/detail/object_array.hpp"
 
 namespace cppa { namespace detail {
 
-object_array::object_array() : super(tuple_impl_info::dynamically_typed) {
+namespace {
+
+// the registry never erases signatures and is bounded, since
+// remote peers could otherwise make it intern arbitrary type sequences;
+// tuples with an unknown signature beyond this limit get no token
+constexpr size_t max_signatures = 1024;
+
+// open addressing table, at most half full
+constexpr size_t num_slots = max_signatures * 2;
+
+struct signature {
+    size_t hash;
+    std::vector<const uniform_type_info*> types;
+};
+
+size_t hash_of(const std::vector<object>& elements) {
+    size_t result = elements.size();
+    for (auto& element : elements) {
+        auto addr = reinterpret_cast<std::uintptr_t>(element.type());
+        result = result * 31 + (addr >> 4);
+    }
+    return result;
+}
+
+bool matches(const signature& sig, size_t hash,
+             const std::vector<object>& elements) {
+    if (sig.hash != hash || sig.types.size() != elements.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (sig.types[i] != elements[i].type()) return false;
+    }
+    return true;
+}
+
+// interns type signatures; the address of an interned signature is used
+// as token; lookups are lock-free and allocate nothing, only inserting
+// a new signature takes the mutex
+class signature_registry {
+
+ public:
+
+    signature_registry() {
+        for (auto& slot : m_slots) slot = nullptr;
+    }
+
+    // returns nullptr if the registry is full
+    const void* intern(const std::vector<object>& elements) {
+        auto hash = hash_of(elements);
+        auto pos = hash % num_slots;
+        for (auto sig = m_slots[pos].load(std::memory_order_acquire);
+             sig != nullptr;
+             sig = m_slots[pos].load(std::memory_order_acquire)) {
+            if (matches(*sig, hash, elements)) return sig;
+            pos = (pos + 1) % num_slots;
+        }
+        std::lock_guard<std::mutex> guard(m_mtx);
+        // another thread might have filled the slot in the meantime
+        for (auto sig = m_slots[pos].load(std::memory_order_acquire);
+             sig != nullptr;
+             sig = m_slots[pos].load(std::memory_order_acquire)) {
+            if (matches(*sig, hash, elements)) return sig;
+            pos = (pos + 1) % num_slots;
+        }
+        if (m_size >= max_signatures) return nullptr;
+        auto sig = new signature{hash, {}};
+        sig->types.reserve(elements.size());
+        for (auto& element : elements) sig->types.push_back(element.type());
+        m_slots[pos].store(sig, std::memory_order_release);
+        ++m_size;
+        return sig;
+    }
+
+ private:
+
+    std::mutex m_mtx;
+    size_t m_size = 0;
+    std::atomic<const signature*> m_slots[num_slots];
+
+};
+
+// never destroyed, since tokens may be used until the very end of main()
+signature_registry& registry() {
+    static signature_registry* s_registry = new signature_registry;
+    return *s_registry;
+}
+
+// marks an object_array whose signature did not fit into the registry
+const char s_no_token = 0;
+
+} // namespace <anonymous>
+
+object_array::object_array() : super(tuple_impl_info::dynamically_typed)
+                             , m_signature(nullptr) {
+}
+
+object_array::object_array(object_array&& other)
+: super(other), m_elements(std::move(other.m_elements))
+, m_signature(other.m_signature.load(std::memory_order_relaxed)) {
+}
+
+object_array::object_array(const object_array& other)
+: super(other), m_elements(other.m_elements)
+, m_signature(other.m_signature.load(std::memory_order_relaxed)) {
 }
 
 void object_array::push_back(const object& what) {
     m_elements.push_back(what);
+    m_signature.store(nullptr, std::memory_order_relaxed);
 }
 
 void object_array::push_back(object&& what) {
     m_elements.push_back(std::move(what));
+    m_signature.store(nullptr, std::memory_order_relaxed);
 }
 
 void* object_array::mutable_at(size_t pos) {
@@ -63,4 +172,14 @@ const uniform_type_info* object_array::type_at(size_t pos) const {
     return m_elements[pos].type();
 }
 
+const void* object_array::signature_token() const {
+    auto result = m_signature.load(std::memory_order_relaxed);
+    if (result == nullptr) {
+        result = registry().intern(m_elements);
+        if (result == nullptr) result = &s_no_token;
+        m_signature.store(result, std::memory_order_relaxed);
+    }
+    return result != &s_no_token ? result : nullptr;
+}
+
 } } // namespace cppa::detail
@@ -51,6 +51,21 @@ void protocol::run_later(std::function<void()> fun) {
     m_parent->run_later(std::move(fun));
 }
 
+void protocol::run_later(middleman_event* what) {
+    CPPA_REQUIRE(m_parent != nullptr);
+    m_parent->run_later(what);
+}
+
+void protocol::run_later(size_t loop, std::function<void()> fun) {
+    CPPA_REQUIRE(m_parent != nullptr);
+    m_parent->run_later(loop, std::move(fun));
+}
+
+void protocol::run_later(size_t loop, middleman_event* what) {
+    CPPA_REQUIRE(m_parent != nullptr);
+    m_parent->run_later(loop, what);
+}
+
 void protocol::continue_reader(continuable_reader* ptr) {
     CPPA_LOG_TRACE(CPPA_ARG(ptr));
     m_parent->continue_reader(ptr);
@@ -242,6 +242,14 @@ channel* scheduler::delayed_send_helper() {
     return m_helper->m_worker.get();
 }
 
+std::vector<actor_ptr> scheduler::spawn_n(std::vector<scheduled_actor*> what,
+                                          scheduling_hint hint) {
+    std::vector<actor_ptr> result;
+    result.reserve(what.size());
+    for (auto ptr : what) result.push_back(spawn(ptr, hint));
+    return result;
+}
+
 void scheduler::register_converted_context(actor* what) {
     if (what) {
         detail::inc_actor_count();
@@ -0,0 +1,266 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+
+#include "cppa/util/shared_spinlock.hpp"
+
+#include "cppa/network/serialized_payload.hpp"
+
+namespace cppa { namespace network {
+
+namespace {
+
+// a message sent to several nodes is usually serialized for all
+// of them at once, thus a small cache is sufficient
+constexpr size_t cache_size = 4;
+
+struct cache_entry {
+    // keeps the tuple alive, because entries are
+    // identified by the address of its content
+    any_tuple msg;
+    serialized_payload_ptr payload;
+};
+
+// number of unused payloads a thread keeps for later messages
+constexpr size_t max_cached = 16;
+
+// number of payloads a thread moves from or to the pool at once
+constexpr size_t fetch_size = 16;
+
+// number of unused payloads shared by all threads
+constexpr size_t max_pooled = 256;
+
+// payloads with larger buffers are released rather than recycled
+constexpr size_t max_recycled_size = 64 * 1024;
+
+// payloads are usually created by a sending thread and released by the
+// middleman after writing them, thus they are recycled via a pool shared
+// by all threads, see detail::basic_memory_cache
+class payload_pool {
+
+ public:
+
+    // moves the last @p num elements of @p storage to the pool
+    // and releases those exceeding its capacity
+    void push(std::vector<serialized_payload*>& storage, size_t num) {
+        auto first = storage.end() - static_cast<std::ptrdiff_t>(num);
+        auto i = first;
+        { // lifetime scope of guard
+            std::lock_guard<util::shared_spinlock> guard(m_lock);
+            auto n = std::min(num, max_pooled - m_elements.size());
+            m_elements.insert(m_elements.end(), i,
+                              i + static_cast<std::ptrdiff_t>(n));
+            i += static_cast<std::ptrdiff_t>(n);
+        }
+        for (; i != storage.end(); ++i) delete *i;
+        storage.erase(first, storage.end());
+    }
+
+    // moves up to @p num elements to @p storage
+    void pop(std::vector<serialized_payload*>& storage, size_t num) {
+        std::lock_guard<util::shared_spinlock> guard(m_lock);
+        auto n = std::min(num, m_elements.size());
+        auto first = m_elements.end() - static_cast<std::ptrdiff_t>(n);
+        storage.insert(storage.end(), first, m_elements.end());
+        m_elements.erase(first, m_elements.end());
+    }
+
+ private:
+
+    util::shared_spinlock m_lock;
+    std::vector<serialized_payload*> m_elements;
+
+};
+
+payload_pool& pool() {
+    // never destroyed, since threads may still release
+    // payloads while static objects are destroyed
+    static payload_pool* instance = new payload_pool;
+    return *instance;
+}
+
+struct payload_cache {
+    cache_entry entries[cache_size];
+    size_t pos = 0;
+    // number of active fan_out_scope objects
+    size_t scopes = 0;
+    // unused payloads, kept apart from the entries, which are in use
+    std::vector<serialized_payload*> unused;
+    payload_cache() { unused.reserve(max_cached + fetch_size); }
+};
+
+pthread_key_t s_key;
+pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
+
+void payload_cache_destructor(void* ptr) {
+    if (ptr) {
+        auto cache = reinterpret_cast<payload_cache*>(ptr);
+        if (!cache->unused.empty()) {
+            pool().push(cache->unused, cache->unused.size());
+        }
+        // payloads released by the entries create a new cache,
+        // which POSIX destroys in its next round of destructor calls
+        delete cache;
+    }
+}
+
+void make_payload_cache_key() {
+    pthread_key_create(&s_key, payload_cache_destructor);
+}
+
+payload_cache& get_payload_cache() {
+    pthread_once(&s_key_once, make_payload_cache_key);
+    auto cache = reinterpret_cast<payload_cache*>(pthread_getspecific(s_key));
+    if (!cache) {
+        cache = new payload_cache;
+        pthread_setspecific(s_key, cache);
+    }
+    return *cache;
+}
+
+// returns an empty payload, re-using one released earlier if possible
+serialized_payload* new_payload() {
+    auto& unused = get_payload_cache().unused;
+    if (unused.empty()) pool().pop(unused, fetch_size);
+    if (unused.empty()) return new serialized_payload;
+    auto result = unused.back();
+    unused.pop_back();
+    return result;
+}
+
+} // namespace <anonymous>
+
+serialized_payload::fan_out_scope::fan_out_scope() {
+    ++get_payload_cache().scopes;
+}
+
+serialized_payload::fan_out_scope::~fan_out_scope() {
+    auto& cache = get_payload_cache();
+    if (--cache.scopes == 0) {
+        // release all messages and payloads
+        for (auto& entry : cache.entries) entry = cache_entry{};
+        cache.pos = 0;
+    }
+}
+
+serialized_payload_ptr serialized_payload::from(const any_tuple& msg,
+                                                actor_addressing* addressing,
+                                                std::uint32_t format) {
+    auto& cache = get_payload_cache();
+    if (cache.scopes == 0) {
+        serialized_payload_ptr result{new_payload()};
+        result->assign(msg, addressing, format);
+        return result;
+    }
+    for (auto& entry : cache.entries) {
+        if (   entry.payload
+            && entry.payload->format() == format
+            && entry.msg.cvals().get() == msg.cvals().get()) {
+            return entry.payload;
+        }
+    }
+    auto& entry = cache.entries[cache.pos];
+    cache.pos = (cache.pos + 1) % cache_size;
+    entry = cache_entry{};
+    serialized_payload_ptr result{new_payload()};
+    result->assign(msg, addressing, format);
+    entry.msg = msg;
+    entry.payload = result;
+    return result;
+}
+
+serialized_payload::serialized_payload() : m_format(0) { }
+
+void serialized_payload::assign(const any_tuple& msg,
+                                actor_addressing* addressing,
+                                std::uint32_t format) {
+    clear();
+    m_format = format;
+    binary_serializer bs(&m_data, addressing);
+    bs.format(format);
+    bs.collect_type_names(&m_type_names);
+    try { bs << msg; }
+    catch (...) {
+        clear();
+        throw;
+    }
+}
+
+void serialized_payload::write_to(binary_serializer& sink) const {
+    size_t pos = 0;
+    for (auto& tname : m_type_names) {
+        sink.write_raw(tname.first - pos, m_data.data() + pos);
+        sink.begin_object(tname.second);
+        pos = tname.first;
+    }
+    sink.write_raw(m_data.size() - pos, m_data.data() + pos);
+}
+
+bool serialized_payload::self_contained(const type_lookup_table* types) const {
+    for (auto& tname : m_type_names) {
+        auto& str = tname.second;
+        if (   str == "@actor"
+            || str == "@group"
+            || str == "@channel"
+            || str == "@0"
+            || (types && !types->contains(str))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void serialized_payload::clear() {
+    m_data.clear();
+    m_type_names.clear();
+}
+
+void serialized_payload::request_deletion() {
+    if (m_data.final_size() > max_recycled_size) {
+        delete this;
+        return;
+    }
+    // keep the buffers for the next message
+    clear();
+    auto& unused = get_payload_cache().unused;
+    unused.push_back(this);
+    // keep max_cached elements after handing over a batch
+    if (unused.size() >= max_cached + fetch_size) {
+        pool().push(unused, unused.size() - max_cached);
+    }
+}
+
+} } // namespace cppa::network
@@ -29,11 +29,42 @@
 
 
 #include "cppa/serializer.hpp"
+#include "cppa/primitive_variant.hpp"
+
+#include "cppa/util/pt_token.hpp"
+#include "cppa/util/pt_dispatch.hpp"
+
+#include "cppa/detail/ptype_to_type.hpp"
 
 namespace cppa {
 
+namespace {
+
+struct array_writer {
+
+    serializer* sink;
+    size_t num;
+    const void* values;
+
+    template<primitive_type PT>
+    void operator()(util::pt_token<PT>) const {
+        typedef typename detail::ptype_to_type<PT>::type value_type;
+        auto i = reinterpret_cast<const value_type*>(values);
+        for (auto e = i + num; i != e; ++i) sink->write_value(*i);
+    }
+
+};
+
+} // namespace <anonymous>
+
 serializer::serializer(actor_addressing* aa) : m_addressing(aa) { }
 
 serializer::~serializer() { }
 
+void serializer::write_array(primitive_type ptype,
+                             size_t num,
+                             const void* values) {
+    util::pt_dispatch(ptype, array_writer{this, num, values});
+}
+
 } // namespace cppa
@@ -126,6 +126,18 @@ network::middleman* singleton_manager::get_middleman() {
     return lazy_get(s_middleman);
 }
 
+bool singleton_manager::set_middleman(network::middleman* ptr) {
+    network::middleman* expected = nullptr;
+    if (s_middleman.compare_exchange_strong(expected, ptr)) {
+        ptr->initialize();
+        return true;
+    }
+    else {
+        ptr->dispose();
+        return false;
+    }
+}
+
 empty_tuple* singleton_manager::get_empty_tuple() {
     return lazy_get(s_empty_tuple);
 }
@@ -202,6 +202,8 @@ class string_deserializer : public deserializer {
     //size_t m_obj_count;
     stack<bool> m_obj_had_left_parenthesis;
     stack<string> m_open_objects;
+    // result of the last seek_object() or peek_object() call
+    string m_type_name;
     network::default_actor_addressing m_addressing;
 
     void skip_space_and_comma() {
@@ -274,31 +276,32 @@ class string_deserializer : public deserializer {
         m_pos = m_str.begin();
     }
 
-    string seek_object() {
+    const string& seek_object() {
         skip_space_and_comma();
         // shortcuts for builtin types
         if (*m_pos == '"') {
-            return "@str";
+            m_type_name = "@str";
         }
         else if (*m_pos == '\'') {
-            return "@atom";
+            m_type_name = "@atom";
         }
         else if (*m_pos == '{') {
-            return "@<>";
+            m_type_name = "@<>";
         }
-        // default case
-        auto substr_end = next_delimiter();
-        if (m_pos == substr_end) {
-            throw_malformed("could not seek object type name");
+        else {
+            auto substr_end = next_delimiter();
+            if (m_pos == substr_end) {
+                throw_malformed("could not seek object type name");
+            }
+            m_type_name.assign(m_pos, substr_end);
+            m_pos = substr_end;
         }
-        string result(m_pos, substr_end);
-        m_pos = substr_end;
-        return result;
+        return m_type_name;
     }
 
-    string peek_object() {
+    const string& peek_object() {
         auto pos = m_pos;
-        string result = seek_object();
+        auto& result = seek_object();
         // restore position in stream
         m_pos = pos;
         return result;
@@ -493,7 +496,7 @@ class string_deserializer : public deserializer {
 
 object from_string(const string& what) {
     string_deserializer strd(what);
-    string uname = strd.peek_object();
+    auto& uname = strd.peek_object();
     auto utype = uniform_type_info::from(uname);
     if (utype == nullptr) {
         throw logic_error(uname + " is not announced");
@@ -263,6 +263,33 @@ actor_ptr thread_pool_scheduler::spawn(scheduled_actor* raw,
     return spawn_impl(std::move(ptr));
 }
 
+std::vector<actor_ptr>
+thread_pool_scheduler::spawn_n(std::vector<scheduled_actor*> what,
+                               scheduling_hint hint) {
+    bool hidden = (hint == scheduled_and_hidden);
+    // account for all actors at once, actors that do not set a behavior
+    // in init() are removed from the count afterwards
+    if (!hidden) inc_actor_count(what.size());
+    std::vector<actor_ptr> result;
+    result.reserve(what.size());
+    for (auto raw : what) {
+        scheduled_actor_ptr ptr{raw};
+        ptr->attach_to_scheduler(this, hidden);
+        if (ptr->has_behavior()) {
+            ptr->ref();
+            if (ptr->impl_type() == context_switching_impl) {
+                m_queue.push_back(ptr.get());
+            }
+        }
+        else {
+            ptr->on_exit();
+            if (!hidden) dec_actor_count();
+        }
+        result.push_back(std::move(ptr));
+    }
+    return result;
+}
+
 #ifndef CPPA_DISABLE_CONTEXT_SWITCHING
 
 actor_ptr thread_pool_scheduler::spawn(void_function fun, scheduling_hint hint) {
@@ -223,11 +223,18 @@ void replace_all(string& str, const char (&before)[RawSize], const char* after)
 const char s_rawan[] = "anonymous namespace";
 const char s_an[] = "@_";
 
+// inline namespace of libstdc++'s C++11 ABI
+const char s_cxx11[] = "std::__cxx11::";
+const char s_std[] = "std::";
+
 } // namespace <anonymous>
 
 namespace cppa { namespace detail {
 
-std::string to_uniform_name(const std::string& dname) {
+std::string to_uniform_name(const std::string& demangled_name) {
+    auto dname = demangled_name;
+    // strip inline namespaces, e.g., std::__cxx11::basic_string
+    replace_all(dname, s_cxx11, s_std);
     auto r = parse_tree::parse(begin(dname), end(dname)).compile();
     // replace compiler-dependent "anonmyous namespace" with "@_"
     replace_all(r, s_rawan, s_an);
@@ -0,0 +1,71 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <mutex>
+
+#include "cppa/type_lookup_table.hpp"
+
+#include "cppa/util/shared_lock_guard.hpp"
+
+namespace cppa {
+
+std::pair<std::uint32_t, bool> type_lookup_table::add(const std::string& tname) {
+    auto i = m_ids.find(tname);
+    if (i != m_ids.end()) return {i->second, false};
+    append(tname);
+    return {static_cast<std::uint32_t>(m_names.size()), true};
+}
+
+void type_lookup_table::append(std::string tname) {
+    auto id = static_cast<std::uint32_t>(m_names.size() + 1);
+    m_ids.insert(std::make_pair(tname, id));
+    std::lock_guard<util::shared_spinlock> guard(m_names_mtx);
+    m_names.push_back(std::move(tname));
+}
+
+const std::string* type_lookup_table::name_of(std::uint32_t id) const {
+    util::shared_lock_guard<util::shared_spinlock> guard(m_names_mtx);
+    return (id > 0 && id <= m_names.size()) ? &m_names[id - 1] : nullptr;
+}
+
+bool type_lookup_table::contains(const std::string& tname) const {
+    return m_ids.count(tname) > 0;
+}
+
+void type_lookup_table::truncate(size_t new_size) {
+    std::lock_guard<util::shared_spinlock> guard(m_names_mtx);
+    while (m_names.size() > new_size) {
+        m_ids.erase(m_names.back());
+        m_names.pop_back();
+    }
+}
+
+} // namespace cppa
@@ -32,12 +32,16 @@
 
 #include <map>
 #include <set>
+#include <mutex>
 #include <locale>
+#include <memory>
 #include <string>
+#include <vector>
 #include <atomic>
 #include <limits>
 #include <cstring>
 #include <cstdint>
+#include <typeinfo>
 #include <type_traits>
 
 #include "cppa/atom.hpp"
@@ -50,7 +54,9 @@
 #include "cppa/intrusive_ptr.hpp"
 #include "cppa/actor_addressing.hpp"
 #include "cppa/uniform_type_info.hpp"
+#include "cppa/binary_deserializer.hpp"
 
+#include "cppa/util/blob.hpp"
 #include "cppa/util/duration.hpp"
 #include "cppa/util/void_type.hpp"
 
@@ -142,7 +148,7 @@ class void_type_tinfo : public uniform_type_info {
     }
 
     void deserialize(void*, deserializer* source) const {
-        string cname = source->seek_object();
+        auto& cname = source->seek_object();
         if (cname != name()) {
             throw logic_error("wrong type name found");
         }
@@ -225,7 +231,7 @@ class group_ptr_tinfo : public util::abstract_uniform_type_info<group_ptr> {
     static void s_deserialize(group_ptr& ptrref,
                               deserializer* source,
                               const string& name) {
-        auto cname = source->seek_object();
+        auto& cname = source->seek_object();
         if (cname != name) {
             if (cname == s_nullptr_type_name) {
                 deserialize_nullptr(source);
@@ -296,7 +302,7 @@ class channel_ptr_tinfo : public util::abstract_uniform_type_info<channel_ptr> {
                               const string& group_ptr_type_name) {
         assert_type_name(source, name);
         source->begin_object(name);
-        string subobj = source->peek_object();
+        auto& subobj = source->peek_object();
         if (subobj == actor_ptr_type_name) {
             actor_ptr tmp;
             actor_ptr_tinfo::s_deserialize(tmp, source, actor_ptr_type_name);
@@ -362,17 +368,55 @@ class any_tuple_tinfo : public util::abstract_uniform_type_info<any_tuple> {
                               deserializer* source,
                               const string& name) {
         uniform_type_info::assert_type_name(source, name);
-        auto result = new detail::object_array;
         source->begin_object(name);
         size_t tuple_size = source->begin_sequence();
+        typedef detail::uniform_type_info_map map_type;
+        // narrows down the announced signatures per element
+        auto node = map_type::tuple_factory_child(uti_map().tuple_factories(),
+                                                  static_cast<std::uint32_t>(tuple_size));
+        // statically typed tuple holding all elements read so far
+        std::unique_ptr<abstract_tuple> tup;
+        map_type::tuple_factory tup_factory{nullptr, nullptr};
+        // used once no announced signature matches
+        std::unique_ptr<detail::object_array> arr;
         for (size_t i = 0; i < tuple_size; ++i) {
-            auto tname = source->peek_object();
+            auto& tname = source->peek_object();
             auto utype = uniform_type_info::from(tname);
-            result->push_back(utype->deserialize(source));
+            node = map_type::tuple_factory_child(node, utype->type_id());
+            if (node) {
+                if (!tup || tup->type_at(i) != utype) {
+                    // another signature with the same prefix matches
+                    auto next = node->candidate;
+                    std::unique_ptr<abstract_tuple> tmp{next.create()};
+                    for (size_t j = 0; j < i; ++j) {
+                        next.move_element(j, tmp->mutable_at(j),
+                                          tup->mutable_at(j));
+                    }
+                    tup = std::move(tmp);
+                    tup_factory = next;
+                }
+                utype->deserialize(tup->mutable_at(i), source);
+                continue;
+            }
+            if (!arr) {
+                // no announced signature matches the received message
+                arr.reset(new detail::object_array);
+                for (size_t j = 0; j < i; ++j) {
+                    arr->push_back(tup->type_at(j)->create());
+                    tup_factory.move_element(j, arr->mutable_at(j),
+                                             tup->mutable_at(j));
+                }
+                tup.reset();
+            }
+            arr->push_back(utype->deserialize(source));
         }
         source->end_sequence();
         source->end_object();
-        atref = any_tuple{result};
+        // signatures below a node for the tuple size have that size,
+        // i.e., tup is complete unless no element was read
+        if (tup) atref = any_tuple{tup.release()};
+        else if (arr) atref = any_tuple{arr.release()};
+        else atref = any_tuple{new detail::object_array};
     }
 
  protected:
@@ -443,7 +487,7 @@ class process_info_ptr_tinfo : public util::abstract_uniform_type_info<process_i
 
     virtual void deserialize(void* instance, deserializer* source) const {
         auto& ptrref = *reinterpret_cast<ptr_type*>(instance);
-        auto cname = source->seek_object();
+        auto& cname = source->seek_object();
         if (cname != name()) {
             if (cname == s_nullptr_type_name) {
                 deserialize_nullptr(source);
@@ -523,6 +567,35 @@ class duration_tinfo : public util::abstract_uniform_type_info<util::duration> {
 
 };
 
+class blob_tinfo : public util::abstract_uniform_type_info<util::blob> {
+
+    virtual void serialize(const void* instance, serializer* sink) const {
+        auto val = reinterpret_cast<const util::blob*>(instance);
+        sink->begin_object(name());
+        sink->write_value(static_cast<uint32_t>(val->size()));
+        sink->write_raw(val->size(), val->data());
+        sink->end_object();
+    }
+
+    virtual void deserialize(void* instance, deserializer* source) const {
+        assert_type_name(source);
+        source->begin_object(name());
+        auto val = reinterpret_cast<util::blob*>(instance);
+        auto size = source->read<uint32_t>();
+        if (typeid(*source) == typeid(binary_deserializer)) {
+            // shares the data with the received frame if possible
+            *val = static_cast<binary_deserializer*>(source)->read_blob(size);
+        }
+        else {
+            vector<char> tmp(size);
+            source->read_raw(size, tmp.data());
+            *val = util::blob(tmp.data(), size);
+        }
+        source->end_object();
+    }
+
+};
+
 template<typename T>
 class int_tinfo : public detail::default_uniform_type_info_impl<T> {
 
@@ -588,6 +661,10 @@ class uniform_type_info_map_helper {
 };
 
 uniform_type_info_map::uniform_type_info_map() {
+    for (auto& entry : m_cache) {
+        entry.key = nullptr;
+        entry.value = nullptr;
+    }
     // inserts all compiler generated raw-names to m_ings
     push<char,                  signed char,
          unsigned char,         short,
@@ -628,6 +705,7 @@ uniform_type_info_map::uniform_type_info_map() {
     insert({raw_name<bool>()}, new bool_tinfo);
     // insert cppa types
     insert({raw_name<util::duration>()}, new duration_tinfo);
+    insert({raw_name<util::blob>()}, new blob_tinfo);
     insert({raw_name<any_tuple>()}, new any_tuple_tinfo);
     insert({raw_name<actor_ptr>()}, new actor_ptr_tinfo);
     insert({raw_name<group_ptr>()}, new group_ptr_tinfo);
@@ -640,6 +718,7 @@ uniform_type_info_map::uniform_type_info_map() {
 }
 
 uniform_type_info_map::~uniform_type_info_map() {
+    m_by_id.clear();
     m_by_rname.clear();
     for (auto& kvp : m_by_uname) {
         delete kvp.second;
@@ -658,12 +737,60 @@ const uniform_type_info* uniform_type_info_map::by_uniform_name(const std::strin
     return (i != m_by_uname.end()) ? i->second : nullptr;
 }
 
+namespace {
+
+inline size_t hash_of(const std::type_info* tinfo) {
+    auto x = reinterpret_cast<std::uintptr_t>(tinfo);
+    return static_cast<size_t>((x >> 4) ^ (x >> 12));
+}
+
+} // namespace <anonymous>
+
+const uniform_type_info* uniform_type_info_map::by_type_info(const std::type_info& tinfo) const {
+    auto pos = hash_of(&tinfo);
+    for (size_t i = 0; i < max_probes; ++i) {
+        auto& entry = m_cache[(pos + i) & (cache_size - 1)];
+        auto key = entry.key.load(std::memory_order_acquire);
+        if (key == &tinfo) {
+            auto result = entry.value.load(std::memory_order_acquire);
+            if (result) return result;
+            break; // another thread is about to set the value
+        }
+        else if (key == nullptr) break;
+    }
+    auto result = by_raw_name(raw_name(tinfo));
+    if (result) add_to_cache(&tinfo, result);
+    return result;
+}
+
+void uniform_type_info_map::add_to_cache(const std::type_info* key,
+                                         const uniform_type_info* value) const {
+    auto pos = hash_of(key);
+    for (size_t i = 0; i < max_probes; ++i) {
+        auto& entry = m_cache[(pos + i) & (cache_size - 1)];
+        const std::type_info* expected = nullptr;
+        if (   entry.key.compare_exchange_strong(expected, key)
+            || expected == key) {
+            entry.value.store(value, std::memory_order_release);
+            return;
+        }
+    }
+    // all probed slots are taken; this type_info object
+    // always uses the slow path
+}
+
+const uniform_type_info* uniform_type_info_map::by_id(std::uint32_t id) const {
+    return (id < m_by_id.size()) ? m_by_id[id] : nullptr;
+}
+
 bool uniform_type_info_map::insert(const std::set<std::string>& raw_names,
                                    uniform_type_info* what) {
     if (m_by_uname.count(what->name()) > 0) {
         delete what;
         return false;
     }
+    what->m_id = static_cast<std::uint32_t>(m_by_id.size());
+    m_by_id.push_back(what);
     m_by_uname.insert(std::make_pair(what->name(), what));
     for (auto& plain_name : raw_names) {
         if (!m_by_rname.insert(std::make_pair(plain_name, what)).second) {
@@ -675,12 +802,41 @@ bool uniform_type_info_map::insert(const std::set<std::string>& raw_names,
     return true;
 }
 
+bool uniform_type_info_map::insert_tuple_factory(const std::vector<const uniform_type_info*>& types,
+                                                 tuple_factory factory) {
+    std::vector<std::uint32_t> keys;
+    keys.reserve(types.size() + 1);
+    keys.push_back(static_cast<std::uint32_t>(types.size()));
+    for (auto t : types) {
+        if (t == nullptr) return false;
+        keys.push_back(t->type_id());
+    }
+    std::lock_guard<std::mutex> guard(m_tuple_factories_mtx);
+    // path[i] is the node reached after i keys or nullptr
+    std::vector<const tuple_factory_node*> path{tuple_factories()};
+    for (auto key : keys) path.push_back(tuple_factory_child(path.back(), key));
+    if (path.back() != nullptr) return false;
+    // copy the path bottom-up, sharing all other nodes with the
+    // current trie, which remains valid for concurrent readers
+    const tuple_factory_node* child = nullptr;
+    for (size_t i = keys.size() + 1; i > 0; --i) {
+        auto old = path[i - 1];
+        std::unique_ptr<tuple_factory_node> node{old ? new tuple_factory_node(*old)
+                                                     : new tuple_factory_node};
+        if (child) node->children[keys[i - 1]] = child;
+        else node->factory = factory;
+        if (node->candidate.create == nullptr) node->candidate = factory;
+        child = node.get();
+        m_tuple_factory_nodes.push_back(std::move(node));
+    }
+    m_tuple_factories.store(child, std::memory_order_release);
+    return true;
+}
+
 std::vector<const uniform_type_info*> uniform_type_info_map::get_all() const {
     std::vector<const uniform_type_info*> result;
-    result.reserve(m_by_uname.size());
-    for (const uti_map_type::value_type& i : m_by_uname) {
-        result.push_back(i.second);
-    }
+    result.reserve(m_by_id.size());
+    for (auto uti : m_by_id) result.push_back(uti);
     return std::move(result);
 }
 
@@ -692,13 +848,22 @@ bool announce(const std::type_info& tinfo, uniform_type_info* utype) {
     return detail::uti_map().insert({detail::raw_name(tinfo)}, utype);
 }
 
-uniform_type_info::uniform_type_info(const std::string& str) : m_name(str) { }
+bool announce_tuple(const std::vector<const uniform_type_info*>& types,
+                    detail::abstract_tuple* (*factory)(),
+                    void (*move_element)(size_t, void*, void*)) {
+    return !types.empty()
+           && detail::uti_map().insert_tuple_factory(types, {factory,
+                                                             move_element});
+}
+
+uniform_type_info::uniform_type_info(const std::string& str)
+: m_name(str), m_id(std::numeric_limits<std::uint32_t>::max()) { }
 
 uniform_type_info::~uniform_type_info() { }
 
 void uniform_type_info::assert_type_name(deserializer* source,
                                          const std::string& expected_name) {
-    auto tname = source->seek_object();
+    auto& tname = source->seek_object();
     if (tname != expected_name) {
         std::string error_msg = "wrong type name found; expected \"";
         error_msg += expected_name;
@@ -718,7 +883,7 @@ object uniform_type_info::create() const {
 }
 
 const uniform_type_info* uniform_type_info::from(const std::type_info& tinf) {
-    auto result = detail::uti_map().by_raw_name(detail::raw_name(tinf));
+    auto result = detail::uti_map().by_type_info(tinf);
     if (result == nullptr) {
         std::string error = "uniform_type_info::by_type_info(): ";
         error += detail::to_uniform_name(tinf);
@@ -736,6 +901,15 @@ const uniform_type_info* uniform_type_info::from(const std::string& name) {
     return result;
 }
 
+const uniform_type_info* uniform_type_info::from_id(std::uint32_t type_id) {
+    auto result = detail::uti_map().by_id(type_id);
+    if (result == nullptr) {
+        throw std::runtime_error("unknown type id: "
+                                 + std::to_string(type_id));
+    }
+    return result;
+}
+
 object uniform_type_info::deserialize(deserializer* from) const {
     auto ptr = new_instance();
     deserialize(ptr, from);
@@ -9,6 +9,8 @@
 #include "cppa/to_string.hpp"
 #include "cppa/guard_expr.hpp"
 
+#include "cppa/detail/object_array.hpp"
+
 using namespace std;
 using namespace cppa;
 
@@ -344,6 +346,77 @@ int main() {
     CPPA_CHECK_EQUAL(3, pmatches);
     */
 
+    // an enabled case group that doesn't match (e.g. because of a guard)
+    // must not affect which of the following groups are enabled
+    int hits = 0;
+    auto guarded = (
+        on<int>().when(_x1 > 10) >> [&]() { hits = 1; },
+        on<float>() >> [&]() { hits = 2; },
+        on<int>() >> [&]() { hits = 3; }
+    );
+    CPPA_CHECK(guarded(make_any_tuple(5)));
+    CPPA_CHECK_EQUAL(3, hits);
+    hits = 0;
+    CPPA_CHECK(guarded(5));
+    CPPA_CHECK_EQUAL(3, hits);
+    CPPA_CHECK(guarded(make_any_tuple(50)));
+    CPPA_CHECK_EQUAL(1, hits);
+
+    // cases with a constant leading atom are dispatched via lookup table,
+    // which must not change which case is selected
+    string last;
+    auto by_atom = (
+        on(atom("get"), 1) >> [&]() { last = "get1"; },
+        on<atom_value, int>() >> [&]() { last = "any"; },
+        on(atom("get")) >> [&]() { last = "get"; },
+        on(atom("put"), arg_match) >> [&](int) { last = "put"; },
+        on(atom("put")) >> [&]() { last = "put0"; }
+    );
+    CPPA_CHECK(by_atom(make_any_tuple(atom("get"), 1)));
+    CPPA_CHECK_EQUAL("get1", last);
+    CPPA_CHECK(by_atom(make_any_tuple(atom("get"), 2)));
+    CPPA_CHECK_EQUAL("any", last);
+    CPPA_CHECK(by_atom(make_any_tuple(atom("put"), 2)));
+    CPPA_CHECK_EQUAL("any", last);
+    CPPA_CHECK(by_atom(make_any_tuple(atom("get"))));
+    CPPA_CHECK_EQUAL("get", last);
+    CPPA_CHECK(by_atom(atom("put")));
+    CPPA_CHECK_EQUAL("put0", last);
+    CPPA_CHECK(!by_atom(make_any_tuple(atom("foo"))));
+    CPPA_CHECK(!by_atom(make_any_tuple(1, 2)));
+
+    // dynamically typed tuples with equal element types share a signature
+    // token and thus a dispatch cache entry
+    auto dynamic_tuple = [](object o0, object o1) -> any_tuple {
+        auto oarr = new detail::object_array;
+        oarr->push_back(std::move(o0));
+        oarr->push_back(std::move(o1));
+        return any_tuple{oarr};
+    };
+    auto d0 = dynamic_tuple(object::from(1), object::from(string("a")));
+    auto d1 = dynamic_tuple(object::from(2), object::from(string("b")));
+    auto d2 = dynamic_tuple(object::from(3), object::from(4));
+    CPPA_CHECK(d0.cvals()->signature_token() != nullptr);
+    CPPA_CHECK_EQUAL(d0.cvals()->signature_token(),
+                     d1.cvals()->signature_token());
+    CPPA_CHECK_NOT_EQUAL(d0.cvals()->signature_token(),
+                         d2.cvals()->signature_token());
+    auto dyn_expr = (
+        on<int, int>() >> [&]() { last = "int,int"; },
+        on<int, string>() >> [&](int i, const string& str) {
+            last = std::to_string(i) + str;
+        },
+        on<float, anything>() >> [&]() { last = "float,..."; }
+    );
+    CPPA_CHECK(dyn_expr(d0));
+    CPPA_CHECK_EQUAL("1a", last);
+    CPPA_CHECK(dyn_expr(d1));
+    CPPA_CHECK_EQUAL("2b", last);
+    CPPA_CHECK(dyn_expr(d2));
+    CPPA_CHECK_EQUAL("int,int", last);
+    CPPA_CHECK(!dyn_expr(dynamic_tuple(object::from(1.0), object::from(1))));
+    CPPA_CHECK(dyn_expr.can_invoke(d0));
+
     // let's get the awesomeness started
 
     istringstream iss("hello world");
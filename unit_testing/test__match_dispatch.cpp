@@ -0,0 +1,209 @@
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <iostream>
+
+#include "test.hpp"
+#include "cppa/cppa.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+constexpr size_t num_rounds = 10000;
+
+typedef chrono::high_resolution_clock clock_type;
+
+typedef void (*send_fun)(const actor_ptr&);
+
+template<typename T0, typename T1>
+void send_sig(const actor_ptr& whom) {
+    send(whom, T0(), T1());
+}
+
+// one sender per message signature (32 distinct type tokens)
+const send_fun senders[] = {
+    send_sig<int8_t,   float>, send_sig<int8_t,   double>,
+    send_sig<int8_t,   string>, send_sig<int8_t,   atom_value>,
+    send_sig<int16_t,  float>, send_sig<int16_t,  double>,
+    send_sig<int16_t,  string>, send_sig<int16_t,  atom_value>,
+    send_sig<int32_t,  float>, send_sig<int32_t,  double>,
+    send_sig<int32_t,  string>, send_sig<int32_t,  atom_value>,
+    send_sig<int64_t,  float>, send_sig<int64_t,  double>,
+    send_sig<int64_t,  string>, send_sig<int64_t,  atom_value>,
+    send_sig<uint8_t,  float>, send_sig<uint8_t,  double>,
+    send_sig<uint8_t,  string>, send_sig<uint8_t,  atom_value>,
+    send_sig<uint16_t, float>, send_sig<uint16_t, double>,
+    send_sig<uint16_t, string>, send_sig<uint16_t, atom_value>,
+    send_sig<uint32_t, float>, send_sig<uint32_t, double>,
+    send_sig<uint32_t, string>, send_sig<uint32_t, atom_value>,
+    send_sig<uint64_t, float>, send_sig<uint64_t, double>,
+    send_sig<uint64_t, string>, send_sig<uint64_t, atom_value>
+};
+
+constexpr size_t num_signatures = sizeof(senders) / sizeof(send_fun);
+
+// counts received messages per signature and reports the
+// total number of messages on {'done'}
+struct dispatcher : event_based_actor {
+    size_t counts[num_signatures];
+    void init() {
+        for (auto& c : counts) c = 0;
+        become (
+            on<int8_t,   float>()      >> [=]() { ++counts[0];  },
+            on<int8_t,   double>()     >> [=]() { ++counts[1];  },
+            on<int8_t,   string>()     >> [=]() { ++counts[2];  },
+            on<int8_t,   atom_value>() >> [=]() { ++counts[3];  },
+            on<int16_t,  float>()      >> [=]() { ++counts[4];  },
+            on<int16_t,  double>()     >> [=]() { ++counts[5];  },
+            on<int16_t,  string>()     >> [=]() { ++counts[6];  },
+            on<int16_t,  atom_value>() >> [=]() { ++counts[7];  },
+            on<int32_t,  float>()      >> [=]() { ++counts[8];  },
+            on<int32_t,  double>()     >> [=]() { ++counts[9];  },
+            on<int32_t,  string>()     >> [=]() { ++counts[10]; },
+            on<int32_t,  atom_value>() >> [=]() { ++counts[11]; },
+            on<int64_t,  float>()      >> [=]() { ++counts[12]; },
+            on<int64_t,  double>()     >> [=]() { ++counts[13]; },
+            on<int64_t,  string>()     >> [=]() { ++counts[14]; },
+            on<int64_t,  atom_value>() >> [=]() { ++counts[15]; },
+            on<uint8_t,  float>()      >> [=]() { ++counts[16]; },
+            on<uint8_t,  double>()     >> [=]() { ++counts[17]; },
+            on<uint8_t,  string>()     >> [=]() { ++counts[18]; },
+            on<uint8_t,  atom_value>() >> [=]() { ++counts[19]; },
+            on<uint16_t, float>()      >> [=]() { ++counts[20]; },
+            on<uint16_t, double>()     >> [=]() { ++counts[21]; },
+            on<uint16_t, string>()     >> [=]() { ++counts[22]; },
+            on<uint16_t, atom_value>() >> [=]() { ++counts[23]; },
+            on<uint32_t, float>()      >> [=]() { ++counts[24]; },
+            on<uint32_t, double>()     >> [=]() { ++counts[25]; },
+            on<uint32_t, string>()     >> [=]() { ++counts[26]; },
+            on<uint32_t, atom_value>() >> [=]() { ++counts[27]; },
+            on<uint64_t, float>()      >> [=]() { ++counts[28]; },
+            on<uint64_t, double>()     >> [=]() { ++counts[29]; },
+            on<uint64_t, string>()     >> [=]() { ++counts[30]; },
+            on<uint64_t, atom_value>() >> [=]() { ++counts[31]; },
+            on(atom("done")) >> [=]() {
+                size_t total = 0;
+                bool all_equal = true;
+                for (auto c : counts) {
+                    total += c;
+                    if (c != counts[0]) all_equal = false;
+                }
+                reply(atom("result"), total, all_equal);
+                quit();
+            }
+        );
+    }
+};
+
+const atom_value atoms[] = {
+    atom("get"), atom("put"), atom("del"), atom("add"),
+    atom("sub"), atom("mul"), atom("div"), atom("inc"),
+    atom("dec"), atom("push"), atom("pop"), atom("peek"),
+    atom("open"), atom("close"), atom("read"), atom("write"),
+    atom("seek"), atom("flush"), atom("lock"), atom("unlock"),
+    atom("start"), atom("stop"), atom("pause"), atom("resume"),
+    atom("ping"), atom("pong"), atom("join"), atom("leave"),
+    atom("sync"), atom("ack"), atom("nack"), atom("reset")
+};
+
+constexpr size_t num_atoms = sizeof(atoms) / sizeof(atom_value);
+
+// same as dispatcher, but dispatches on the leading atom of
+// 32 {atom, int} messages
+struct atom_dispatcher : event_based_actor {
+    size_t counts[num_atoms];
+    void init() {
+        for (auto& c : counts) c = 0;
+        become (
+            on(atom("get"), arg_match) >> [=](int) { ++counts[0]; },
+            on(atom("put"), arg_match) >> [=](int) { ++counts[1]; },
+            on(atom("del"), arg_match) >> [=](int) { ++counts[2]; },
+            on(atom("add"), arg_match) >> [=](int) { ++counts[3]; },
+            on(atom("sub"), arg_match) >> [=](int) { ++counts[4]; },
+            on(atom("mul"), arg_match) >> [=](int) { ++counts[5]; },
+            on(atom("div"), arg_match) >> [=](int) { ++counts[6]; },
+            on(atom("inc"), arg_match) >> [=](int) { ++counts[7]; },
+            on(atom("dec"), arg_match) >> [=](int) { ++counts[8]; },
+            on(atom("push"), arg_match) >> [=](int) { ++counts[9]; },
+            on(atom("pop"), arg_match) >> [=](int) { ++counts[10]; },
+            on(atom("peek"), arg_match) >> [=](int) { ++counts[11]; },
+            on(atom("open"), arg_match) >> [=](int) { ++counts[12]; },
+            on(atom("close"), arg_match) >> [=](int) { ++counts[13]; },
+            on(atom("read"), arg_match) >> [=](int) { ++counts[14]; },
+            on(atom("write"), arg_match) >> [=](int) { ++counts[15]; },
+            on(atom("seek"), arg_match) >> [=](int) { ++counts[16]; },
+            on(atom("flush"), arg_match) >> [=](int) { ++counts[17]; },
+            on(atom("lock"), arg_match) >> [=](int) { ++counts[18]; },
+            on(atom("unlock"), arg_match) >> [=](int) { ++counts[19]; },
+            on(atom("start"), arg_match) >> [=](int) { ++counts[20]; },
+            on(atom("stop"), arg_match) >> [=](int) { ++counts[21]; },
+            on(atom("pause"), arg_match) >> [=](int) { ++counts[22]; },
+            on(atom("resume"), arg_match) >> [=](int) { ++counts[23]; },
+            on(atom("ping"), arg_match) >> [=](int) { ++counts[24]; },
+            on(atom("pong"), arg_match) >> [=](int) { ++counts[25]; },
+            on(atom("join"), arg_match) >> [=](int) { ++counts[26]; },
+            on(atom("leave"), arg_match) >> [=](int) { ++counts[27]; },
+            on(atom("sync"), arg_match) >> [=](int) { ++counts[28]; },
+            on(atom("ack"), arg_match) >> [=](int) { ++counts[29]; },
+            on(atom("nack"), arg_match) >> [=](int) { ++counts[30]; },
+            on(atom("reset"), arg_match) >> [=](int) { ++counts[31]; },
+            on(atom("done")) >> [=]() {
+                size_t total = 0;
+                bool all_equal = true;
+                for (auto c : counts) {
+                    total += c;
+                    if (c != counts[0]) all_equal = false;
+                }
+                reply(atom("result"), total, all_equal);
+                quit();
+            }
+        );
+    }
+};
+
+// returns {total number of received messages, all types received equally}
+template<typename F>
+pair<size_t, bool> run(const char* what, const actor_ptr& whom,
+                       size_t num_types, F send_all) {
+    pair<size_t, bool> result{0, false};
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < num_rounds; ++i) send_all();
+    send(whom, atom("done"));
+    receive (
+        on(atom("result"), arg_match) >> [&](size_t total, bool all_equal) {
+            result = make_pair(total, all_equal);
+        },
+        after(chrono::seconds(30)) >> [] {
+            cerr << "timeout while waiting for result" << endl;
+        }
+    );
+    auto t1 = clock_type::now();
+    auto ms = chrono::duration_cast<chrono::milliseconds>(t1 - t0);
+    cout << what << ": dispatched " << (num_rounds * num_types)
+         << " messages with " << num_types
+         << " distinct types in " << ms.count() << "ms" << endl;
+    return result;
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test__match_dispatch);
+    auto d = spawn<dispatcher>();
+    auto res = run("signatures", d, num_signatures, [&] {
+        for (auto sf : senders) sf(d);
+    });
+    CPPA_CHECK_EQUAL(num_rounds * num_signatures, res.first);
+    CPPA_CHECK(res.second);
+    d = spawn<atom_dispatcher>();
+    res = run("leading atoms", d, num_atoms, [&] {
+        for (auto a : atoms) send(d, a, 42);
+    });
+    CPPA_CHECK_EQUAL(num_rounds * num_atoms, res.first);
+    CPPA_CHECK(res.second);
+    await_all_others_done();
+    shutdown();
+    return CPPA_TEST_RESULT;
+}
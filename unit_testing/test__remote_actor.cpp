@@ -9,6 +9,22 @@
 #include "cppa/cppa.hpp"
 #include "cppa/logging.hpp"
 #include "cppa/exception.hpp"
+#include "cppa/binary_serializer.hpp"
+#include "cppa/binary_deserializer.hpp"
+#include "cppa/util/buffer.hpp"
+#include "cppa/network/middleman.hpp"
+#include "cppa/network/ipv4_acceptor.hpp"
+#include "cppa/network/ipv4_io_stream.hpp"
+#include "cppa/network/message_header.hpp"
+#include "cppa/network/default_protocol.hpp"
+#include "cppa/network/default_actor_addressing.hpp"
+
+#ifdef CPPA_IO_URING
+#   include <dirent.h>
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#   include <linux/io_uring.h>
+#endif
 
 using namespace std;
 using namespace cppa;
@@ -221,6 +237,156 @@ int client_part(const vector<string_pair>& args) {
     return CPPA_TEST_RESULT;
 }
 
+// process id and node ids of simulated nodes running a libcppa
+// version without wire features, i.e., using the legacy format
+constexpr uint32_t legacy_pid = 4242;
+
+process_information::node_id_type legacy_node_id(uint8_t fill_value) {
+    process_information::node_id_type result;
+    result.fill(fill_value);
+    return result;
+}
+
+void read_legacy_frame(network::input_stream& in,
+                       network::message_header& hdr,
+                       any_tuple& msg) {
+    network::default_actor_addressing addressing;
+    uint32_t size;
+    in.read(&size, sizeof(uint32_t));
+    vector<char> buf(size);
+    in.read(buf.data(), size);
+    binary_deserializer bd(buf.data(), buf.size(), &addressing);
+    bd.format(legacy_binary_format);
+    uniform_typeid<network::message_header>()->deserialize(&hdr, &bd);
+    uniform_typeid<any_tuple>()->deserialize(&msg, &bd);
+}
+
+void write_legacy_frame(network::output_stream& out,
+                        const network::message_header& hdr,
+                        const any_tuple& msg) {
+    network::default_actor_addressing addressing;
+    util::buffer buf;
+    binary_serializer bs(&buf, &addressing);
+    bs.format(legacy_binary_format);
+    bs << hdr << msg;
+    auto size = static_cast<uint32_t>(buf.size());
+    out.write(&size, sizeof(uint32_t));
+    out.write(buf.data(), buf.size());
+}
+
+// connects to the published actor like a node without wire features
+int legacy_connecting_node_part(uint16_t port) {
+    CPPA_TEST(test__remote_actor_legacy_connecting_node);
+    auto pself = process_information::get();
+    auto io = network::ipv4_io_stream::connect_to("127.0.0.1", port);
+    auto nid = legacy_node_id(0x42);
+    io->write(&legacy_pid, sizeof(uint32_t));
+    io->write(nid.data(), nid.size());
+    actor_id aid;
+    uint32_t pid;
+    io->read(&aid, sizeof(actor_id));
+    io->read(&pid, sizeof(uint32_t));
+    io->read(nid.data(), nid.size());
+    CPPA_CHECK_EQUAL(self->id(), aid);
+    CPPA_CHECK_EQUAL(pself->process_id(), pid);
+    CPPA_CHECK(nid == pself->node_id());
+    // the acceptor announces its features in a message without receiver
+    network::message_header hdr;
+    any_tuple msg;
+    read_legacy_frame(*io, hdr, msg);
+    CPPA_CHECK(hdr.receiver == nullptr);
+    CPPA_CHECK(msg == make_cow_tuple(atom("FEATURES"),
+                           network::default_protocol::supported_features()));
+    // ignoring it, messages in the legacy format remain valid
+    actor_ptr receiver = self;
+    write_legacy_frame(*io, {nullptr, receiver}, make_any_tuple(atom("legacy"), 42));
+    receive (
+        on(atom("legacy"), 42) >> [] { },
+        after(chrono::seconds(5)) >> [&] {
+            CPPA_ERROR("no message received from legacy node within 5s");
+        }
+    );
+    return CPPA_TEST_RESULT;
+}
+
+// accepts a connection from remote_actor() like a node without wire features
+int legacy_acceptor_part() {
+    CPPA_TEST(test__remote_actor_legacy_acceptor);
+    uint16_t port = 4343;
+    unique_ptr<network::acceptor> acceptor;
+    while (!acceptor) {
+        try { acceptor = network::ipv4_acceptor::create(port, "127.0.0.1"); }
+        catch (bind_failure&) { ++port; }
+    }
+    thread legacy_node([&] {
+        auto pself = process_information::get();
+        auto io = acceptor->accept_connection();
+        auto nid = legacy_node_id(0x43);
+        actor_id aid = 1;
+        io.second->write(&aid, sizeof(actor_id));
+        io.second->write(&legacy_pid, sizeof(uint32_t));
+        io.second->write(nid.data(), nid.size());
+        uint32_t pid;
+        io.first->read(&pid, sizeof(uint32_t));
+        io.first->read(nid.data(), nid.size());
+        CPPA_CHECK_EQUAL(pself->process_id(), pid);
+        CPPA_CHECK(nid == pself->node_id());
+        // the proxy created by remote_actor() is monitored
+        // using a message in the legacy format
+        network::message_header hdr;
+        any_tuple msg;
+        read_legacy_frame(*io.first, hdr, msg);
+        CPPA_CHECK(hdr.receiver == nullptr);
+        match(msg) (
+            on(atom("MONITOR"), arg_match) >> [&](const process_information_ptr& node,
+                                                  actor_id monitored) {
+                CPPA_CHECK(node != nullptr && *node == *pself);
+                CPPA_CHECK_EQUAL(aid, monitored);
+            },
+            others() >> [&] {
+                CPPA_ERROR("unexpected: " << to_string(msg));
+            }
+        );
+    });
+    // returns once the handshake is done
+    auto legacy_actor = remote_actor("127.0.0.1", port);
+    CPPA_CHECK(legacy_actor != nullptr);
+    legacy_node.join();
+    return CPPA_TEST_RESULT;
+}
+
+#ifdef CPPA_IO_URING
+
+// the middleman falls back to epoll if the kernel does not support io_uring
+bool io_uring_supported() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(io_uring_params));
+    auto fd = syscall(__NR_io_uring_setup, 1, &params);
+    if (fd < 0) return false;
+    close(static_cast<int>(fd));
+    return true;
+}
+
+// checks whether this process has an io_uring instance
+bool uses_io_uring() {
+    auto dir = opendir("/proc/self/fd");
+    if (dir == nullptr) return false;
+    bool result = false;
+    while (auto entry = readdir(dir)) {
+        string path = "/proc/self/fd/";
+        path += entry->d_name;
+        char target[64];
+        auto len = readlink(path.c_str(), target, sizeof(target) - 1);
+        if (len > 0 && string(target, len) == "anon_inode:[io_uring]") {
+            result = true;
+        }
+    }
+    closedir(dir);
+    return result;
+}
+
+#endif // CPPA_IO_URING
+
 } // namespace <anonymous>
 
 void verbose_terminate() {
@@ -238,6 +404,9 @@ void verbose_terminate() {
 
 int main(int argc, char** argv) {
     set_terminate(verbose_terminate);
+    // connections are handled by the event loop of their node,
+    // incoming connections move there after the handshake
+    network::set_default_middleman(4);
     announce<actor_vector>();
     cout.unsetf(ios_base::unitbuf);
     string app_path = argv[0];
@@ -268,6 +437,10 @@ int main(int argc, char** argv) {
         }
     }
     while (!success);
+#   ifdef CPPA_IO_URING
+    // publish() has started the middleman
+    if (io_uring_supported()) CPPA_CHECK(uses_io_uring());
+#   endif
     thread child;
     ostringstream oss;
     if (run_remote_actor) {
@@ -361,6 +534,16 @@ int main(int argc, char** argv) {
     );
     // wait until separate process (in sep. thread) finished execution
     if (run_remote_actor) child.join();
+    cout << "test connections to nodes using the legacy format" << endl;
+    CPPA_CHECK_EQUAL(0, legacy_connecting_node_part(port));
+    CPPA_CHECK_EQUAL(0, legacy_acceptor_part());
+    auto stats = network::default_protocol::statistics();
+    cout << "received " << stats.messages_read << " messages using "
+         << stats.reads_per_message() << " reads per message, sent "
+         << stats.messages_written << " messages using "
+         << stats.writes_per_message() << " writes per message" << endl;
+    CPPA_CHECK(stats.messages_read > 0);
+    CPPA_CHECK(stats.messages_written > 0);
     shutdown();
     return CPPA_TEST_RESULT;
 }
@@ -40,15 +40,19 @@
 #include "cppa/primitive_type.hpp"
 #include "cppa/primitive_variant.hpp"
 #include "cppa/binary_serializer.hpp"
+#include "cppa/type_lookup_table.hpp"
 #include "cppa/binary_deserializer.hpp"
 
+#include "cppa/util/blob.hpp"
 #include "cppa/util/pt_token.hpp"
 #include "cppa/util/is_iterable.hpp"
 #include "cppa/util/is_primitive.hpp"
 #include "cppa/util/abstract_uniform_type_info.hpp"
 
+#include "cppa/network/serialized_payload.hpp"
 #include "cppa/network/default_actor_addressing.hpp"
 
+#include "cppa/detail/lazy_tuple.hpp"
 #include "cppa/detail/object_array.hpp"
 #include "cppa/detail/type_to_ptype.hpp"
 #include "cppa/detail/ptype_to_type.hpp"
@@ -109,6 +113,54 @@ bool operator!=(const struct_c& lhs, const struct_c& rhs) {
     return !(lhs == rhs);
 }
 
+struct struct_d {
+    vector<int32_t> ints;
+    vector<double> doubles;
+    vector<uint8_t> bytes;
+};
+
+bool operator==(const struct_d& lhs, const struct_d& rhs) {
+    return    lhs.ints == rhs.ints
+           && lhs.doubles == rhs.doubles
+           && lhs.bytes == rhs.bytes;
+}
+
+bool operator!=(const struct_d& lhs, const struct_d& rhs) {
+    return !(lhs == rhs);
+}
+
+// padded, i.e., members are packed before writing
+struct struct_e {
+    int32_t a;
+    double b;
+    uint16_t c;
+};
+
+bool operator==(const struct_e& lhs, const struct_e& rhs) {
+    return lhs.a == rhs.a && lhs.b == rhs.b && lhs.c == rhs.c;
+}
+
+// written as is
+struct struct_f {
+    int32_t x;
+    int32_t y;
+    float z;
+};
+
+bool operator==(const struct_f& lhs, const struct_f& rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+}
+
+// not packable
+struct struct_g {
+    string name;
+    uint64_t id;
+};
+
+bool operator==(const struct_g& lhs, const struct_g& rhs) {
+    return lhs.name == rhs.name && lhs.id == rhs.id;
+}
+
 static const char* msg1str = u8R"__({ @i32 ( 42 ), "Hello \"World\"!" })__";
 
 struct raw_struct {
@@ -261,6 +313,111 @@ int main() {
     }
     catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
 
+    try { // type names are sent only once when using a type_lookup_table
+        any_tuple msg1 = make_any_tuple(42, string("foo"), atom("bar"));
+        type_lookup_table outgoing;
+        type_lookup_table incoming;
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing, &outgoing);
+        bs << msg1;
+        auto first_size = wr_buf.size();
+        bs << msg1;
+        auto second_size = wr_buf.size() - first_size;
+        CPPA_CHECK(second_size < first_size);
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(),
+                               &addressing, &incoming);
+        any_tuple tup1;
+        any_tuple tup2;
+        uniform_typeid<any_tuple>()->deserialize(&tup1, &bd);
+        uniform_typeid<any_tuple>()->deserialize(&tup2, &bd);
+        CPPA_CHECK(msg1 == tup1);
+        CPPA_CHECK(msg1 == tup2);
+        CPPA_CHECK_EQUAL(outgoing.size(), incoming.size());
+    }
+    catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
+
+    try { // announced signatures are deserialized into tuple_vals
+        CPPA_CHECK((announce_tuple<int32_t, string, atom_value>()));
+        CPPA_CHECK(!(announce_tuple<int32_t, string, atom_value>()));
+        // same size and prefix
+        CPPA_CHECK((announce_tuple<int32_t, string, double>()));
+        auto msg1 = make_any_tuple(42, string("foo"), atom("bar"));
+        auto msg2 = make_any_tuple(42, string("foo"), 1.5);
+        // same size and prefix, but not announced
+        auto msg3 = make_any_tuple(42, string("foo"), 23);
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << msg1 << msg2 << msg3;
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+        any_tuple tup1;
+        any_tuple tup2;
+        any_tuple tup3;
+        uniform_typeid<any_tuple>()->deserialize(&tup1, &bd);
+        uniform_typeid<any_tuple>()->deserialize(&tup2, &bd);
+        uniform_typeid<any_tuple>()->deserialize(&tup3, &bd);
+        CPPA_CHECK(msg1 == tup1);
+        CPPA_CHECK(msg2 == tup2);
+        CPPA_CHECK(msg3 == tup3);
+        CPPA_CHECK(tup1.impl_type() == detail::statically_typed);
+        CPPA_CHECK(tup1.type_token() == msg1.type_token());
+        CPPA_CHECK(tup2.impl_type() == detail::statically_typed);
+        CPPA_CHECK(tup2.type_token() == msg2.type_token());
+        CPPA_CHECK(tup3.impl_type() == detail::dynamically_typed);
+        auto tup4 = from_string(to_string(msg1));
+        CPPA_CHECK(msg1 == get<any_tuple>(tup4));
+        CPPA_CHECK(get<any_tuple>(tup4).impl_type() == detail::statically_typed);
+    }
+    catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
+
+    // floating points are written as IEEE 754 values by default,
+    // legacy_binary_format writes decimal strings
+    for (auto fmt : {default_binary_format, legacy_binary_format}) {
+        try {
+            auto msg1 = make_any_tuple(0.1f, 1.0 / 3.0, -2.5e-300,
+                                       numeric_limits<double>::max());
+            util::buffer wr_buf;
+            binary_serializer bs(&wr_buf, &addressing);
+            bs.format(fmt);
+            bs << msg1;
+            binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+            bd.format(fmt);
+            any_tuple msg2;
+            uniform_typeid<any_tuple>()->deserialize(&msg2, &bd);
+            CPPA_CHECK(msg1 == msg2);
+            wr_buf.clear();
+            bs.write_value(1.0 / 3.0);
+            if (fmt == default_binary_format) {
+                CPPA_CHECK_EQUAL(sizeof(double), wr_buf.size());
+            }
+        }
+        catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
+    }
+
+    try { // typed access produces the same output as write_value
+        util::buffer buf1;
+        util::buffer buf2;
+        binary_serializer bs1(&buf1);
+        binary_serializer bs2(&buf2);
+        bs1.write_value(int32_t{-42});
+        bs1.write_value(2.5);
+        bs1.write_value(string("hello world"));
+        bs1.write_value(u16string(u"hello"));
+        bs2.write(int32_t{-42});
+        bs2.write(2.5);
+        bs2.write(string("hello world"));
+        bs2.write(u16string(u"hello"));
+        CPPA_CHECK_EQUAL(buf1.size(), buf2.size());
+        CPPA_CHECK(memcmp(buf1.data(), buf2.data(), buf1.size()) == 0);
+        binary_deserializer bd(buf2.data(), buf2.size());
+        CPPA_CHECK_EQUAL(bd.read<int32_t>(), -42);
+        CPPA_CHECK_EQUAL(bd.read<double>(), 2.5);
+        string str;
+        bd.read(str);
+        CPPA_CHECK_EQUAL(str, "hello world");
+        CPPA_CHECK(bd.read<u16string>() == u"hello");
+    }
+    catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
+
     CPPA_CHECK((is_iterable<int>::value) == false);
     // string is primitive and thus not identified by is_iterable
     CPPA_CHECK((is_iterable<string>::value) == false);
@@ -333,5 +490,265 @@ int main() {
         // verify result of serialization / deserialization
         CPPA_CHECK(c1 == c2);
     }
+    { // vectors of primitives are written as a single block
+        announce<struct_d>(&struct_d::ints,
+                           &struct_d::doubles,
+                           &struct_d::bytes);
+        struct_d d1;
+        for (int32_t i = -500; i < 500; ++i) {
+            d1.ints.push_back(i * 1000);
+            d1.doubles.push_back(i / 3.0);
+            d1.bytes.push_back(static_cast<uint8_t>(i));
+        }
+        for (auto fmt : {default_binary_format, legacy_binary_format}) {
+            util::buffer wr_buf;
+            binary_serializer bs(&wr_buf, &addressing);
+            bs.format(fmt);
+            bs << d1;
+            binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+            bd.format(fmt);
+            object res;
+            bd >> res;
+            CPPA_CHECK_EQUAL(res.type()->name(), "struct_d");
+            CPPA_CHECK(d1 == get<struct_d>(res));
+        }
+        // the string serializer writes each element separately
+        struct_d d2;
+        d2.ints = {1, 2, 3};
+        d2.doubles = {0.5};
+        auto d2str = to_string(object::from(d2));
+        CPPA_CHECK_EQUAL(d2str, "struct_d ( { 1, 2, 3 }, { 0.5 }, { } )");
+        auto d3 = get<struct_d>(from_string(d2str));
+        CPPA_CHECK(d2.ints == d3.ints);
+        CPPA_CHECK(d2.doubles == d3.doubles);
+        // the block has the same layout as individually written elements
+        util::buffer buf1;
+        util::buffer buf2;
+        binary_serializer bs1(&buf1);
+        binary_serializer bs2(&buf2);
+        detail::default_serialize_policy policy;
+        policy(d1.doubles, &bs1);
+        policy(list<double>(d1.doubles.begin(), d1.doubles.end()), &bs2);
+        CPPA_CHECK_EQUAL(buf1.size(), buf2.size());
+        CPPA_CHECK(memcmp(buf1.data(), buf2.data(), buf1.size()) == 0);
+        // a truncated block is detected before reading past the end
+        binary_deserializer bd(buf1.data(), buf1.size() - 1);
+        vector<double> doubles;
+        try {
+            policy(doubles, &bd);
+            CPPA_ERROR("truncated block not detected");
+        }
+        catch (out_of_range&) { }
+    }
+    { // structs announced with announce_fused
+        announce_fused<struct_e>(&struct_e::a, &struct_e::b, &struct_e::c);
+        announce_fused<struct_f>(&struct_f::x, &struct_f::y, &struct_f::z);
+        announce_fused<struct_g>(&struct_g::name, &struct_g::id);
+        announce<vector<struct_e>>();
+        announce<vector<struct_f>>();
+        announce<vector<struct_g>>();
+        vector<struct_e> es;
+        vector<struct_f> fs;
+        vector<struct_g> gs;
+        for (int32_t i = -100; i < 100; ++i) {
+            es.push_back(struct_e{i, i / 7.0, static_cast<uint16_t>(i)});
+            fs.push_back(struct_f{i, -i, i / 2.0f});
+            gs.push_back(struct_g{to_string(i), static_cast<uint64_t>(i)});
+        }
+        detail::default_serialize_policy policy;
+        auto formats = {default_binary_format,
+                        legacy_binary_format,
+                        default_binary_format | varint_integers};
+        for (auto fmt : formats) {
+            util::buffer buf;
+            binary_serializer bs(&buf, &addressing);
+            bs.format(fmt);
+            bs << es.front() << fs.front() << gs.front();
+            policy(es, &bs);
+            policy(fs, &bs);
+            policy(gs, &bs);
+            binary_deserializer bd(buf.data(), buf.size(), &addressing);
+            bd.format(fmt);
+            object e, f, g;
+            bd >> e >> f >> g;
+            CPPA_CHECK(get<struct_e>(e) == es.front());
+            CPPA_CHECK(get<struct_f>(f) == fs.front());
+            CPPA_CHECK(get<struct_g>(g) == gs.front());
+            vector<struct_e> es2;
+            vector<struct_f> fs2;
+            vector<struct_g> gs2;
+            policy(es2, &bd);
+            policy(fs2, &bd);
+            policy(gs2, &bd);
+            CPPA_CHECK(es == es2);
+            CPPA_CHECK(fs == fs2);
+            CPPA_CHECK(gs == gs2);
+        }
+        // a packed struct has the same layout as separately written members
+        util::buffer buf1;
+        util::buffer buf2;
+        binary_serializer bs1(&buf1);
+        binary_serializer bs2(&buf2);
+        bs1 << es.front();
+        bs2.begin_object("struct_e");
+        bs2.write(es.front().a);
+        bs2.write(es.front().b);
+        bs2.write(es.front().c);
+        CPPA_CHECK_EQUAL(buf1.size(), buf2.size());
+        CPPA_CHECK(memcmp(buf1.data(), buf2.data(), buf1.size()) == 0);
+        // vectors are written without type names per element
+        buf1.clear();
+        policy(fs, &bs1);
+        CPPA_CHECK_EQUAL(buf1.size(), sizeof(uint32_t) + fs.size() * 12);
+        // the string serializer writes each member separately
+        struct_e e0{-1, 0.25, 7};
+        auto estr = to_string(object::from(e0));
+        CPPA_CHECK_EQUAL(estr, "struct_e ( -1, 0.25, 7 )");
+        CPPA_CHECK(get<struct_e>(from_string(estr)) == e0);
+        auto gstr = to_string(object::from(gs.front()));
+        CPPA_CHECK_EQUAL(gstr, "struct_g ( \"-100\", 18446744073709551516 )");
+        CPPA_CHECK(get<struct_g>(from_string(gstr)) == gs.front());
+    }
+    { // a serialized payload produces the same output for each connection
+        auto msg = make_any_tuple(atom("payload"), string("abc"),
+                                  make_any_tuple(1, 2.5), self);
+        for (auto fmt : {default_binary_format, legacy_binary_format}) {
+            network::serialized_payload payload;
+            payload.assign(msg, &addressing, fmt);
+            // one connection without and one with type dictionary
+            type_lookup_table types1;
+            type_lookup_table types2;
+            for (auto types : {(type_lookup_table*) nullptr, &types1}) {
+                util::buffer buf1;
+                util::buffer buf2;
+                binary_serializer bs1(&buf1, &addressing, types);
+                binary_serializer bs2(&buf2, &addressing,
+                                      types ? &types2 : nullptr);
+                bs1.format(fmt);
+                bs2.format(fmt);
+                for (int i = 0; i < 2; ++i) {
+                    bs1 << msg;
+                    payload.write_to(bs2);
+                }
+                CPPA_CHECK_EQUAL(buf1.size(), buf2.size());
+                CPPA_CHECK(memcmp(buf1.data(), buf2.data(), buf1.size()) == 0);
+            }
+        }
+    }
+    { // senders share payloads of messages sent to several nodes
+        auto msg = make_any_tuple(atom("shared"), 42);
+        auto from = [&](std::uint32_t format) {
+            return network::serialized_payload::from(msg, &addressing, format);
+        };
+        {
+            network::serialized_payload::fan_out_scope scope1;
+            auto p1 = from(default_binary_format);
+            {
+                network::serialized_payload::fan_out_scope scope2;
+                CPPA_CHECK(p1 == from(default_binary_format));
+            }
+            auto p2 = from(default_binary_format);
+            auto p3 = from(legacy_binary_format);
+            CPPA_CHECK(p1 == p2);
+            CPPA_CHECK(p1 != p3);
+            CPPA_CHECK_EQUAL(default_binary_format, p1->format());
+            CPPA_CHECK_EQUAL(legacy_binary_format, p3->format());
+            CPPA_CHECK(p1->size() > 0);
+            CPPA_CHECK(msg.cvals()->get_reference_count() > 1);
+        }
+        // leaving the scope releases the message
+        CPPA_CHECK_EQUAL(1, msg.cvals()->get_reference_count());
+        auto p4 = from(default_binary_format);
+        CPPA_CHECK(p4 != from(default_binary_format));
+        CPPA_CHECK_EQUAL(1, msg.cvals()->get_reference_count());
+        // payloads are recycled once they are no longer referenced
+        auto addr = p4.get();
+        auto size = p4->size();
+        p4.reset();
+        auto p5 = from(legacy_binary_format);
+        CPPA_CHECK(p5.get() == addr);
+        CPPA_CHECK_EQUAL(legacy_binary_format, p5->format());
+        p5.reset();
+        p5 = from(default_binary_format);
+        CPPA_CHECK(p5.get() == addr);
+        CPPA_CHECK_EQUAL(size, p5->size());
+    }
+    { // lazy tuples are deserialized on first access
+        auto msg = make_any_tuple(atom("lazy"), string("abc"), 4.5,
+                                  make_any_tuple(1, 2));
+        util::buffer buf;
+        type_lookup_table out_types;
+        auto in_types = make_shared<type_lookup_table>();
+        binary_serializer bs(&buf, &addressing, &out_types);
+        bs << msg;
+        { // read type names from the first message, as a connection would
+            binary_deserializer bd(buf.data(), buf.size(),
+                                   &addressing, in_types.get());
+            any_tuple tmp;
+            uniform_typeid<any_tuple>()->deserialize(&tmp, &bd);
+            CPPA_CHECK(tmp == msg);
+        }
+        // the second message contains type ids only
+        buf.clear();
+        bs << msg;
+        any_tuple lazy{new detail::lazy_tuple(util::blob(buf.data(), buf.size()),
+                                              default_binary_format,
+                                              in_types)};
+        CPPA_CHECK_EQUAL(lazy.size(), 4);
+        CPPA_CHECK(lazy.type_at(0) == uniform_typeid<atom_value>());
+        CPPA_CHECK(lazy == msg);
+        // actors cannot be deserialized without addressing
+        buf.clear();
+        bs << make_any_tuple(self);
+        any_tuple invalid{new detail::lazy_tuple(util::blob(buf.data(), buf.size()),
+                                                 default_binary_format,
+                                                 in_types)};
+        CPPA_CHECK_EQUAL(invalid.size(), 0);
+    }
+    { // blobs refer to the buffer of their deserializer if it has an owner
+        struct frame : ref_counted { util::buffer buf; };
+        intrusive_ptr<frame> owner{new frame};
+        util::blob b1{"hello blob", 10};
+        binary_serializer bs(&owner->buf, &addressing);
+        bs << make_any_tuple(b1, 42);
+        auto mt = uniform_typeid<any_tuple>();
+        any_tuple msg;
+        { // deserializer shares the owner
+            binary_deserializer bd(owner->buf.data(), owner->buf.size(),
+                                   &addressing);
+            bd.data_owner(owner);
+            mt->deserialize(&msg, &bd);
+        }
+        CPPA_CHECK_EQUAL(msg.size(), 2);
+        auto& b2 = msg.get_as<util::blob>(0);
+        CPPA_CHECK(b1 == b2);
+        CPPA_CHECK_EQUAL(msg.get_as<int>(1), 42);
+        auto first = owner->buf.data();
+        auto last = first + owner->buf.size();
+        CPPA_CHECK(b2.data() >= first && b2.data() + b2.size() <= last);
+        CPPA_CHECK(b2.owner() == owner);
+        CPPA_CHECK(!owner->unique());
+        msg = any_tuple{};
+        CPPA_CHECK(owner->unique());
+        { // without owner, the blob copies its data
+            binary_deserializer bd(owner->buf.data(), owner->buf.size(),
+                                   &addressing);
+            mt->deserialize(&msg, &bd);
+        }
+        CPPA_CHECK(owner->unique());
+        CPPA_CHECK(b1 == msg.get_as<util::blob>(0));
+        // the string serializer writes blobs as well
+        auto b3 = get<util::blob>(from_string(to_string(object::from(b1))));
+        CPPA_CHECK(b1 == b3);
+        // slices share data with their origin
+        auto b4 = b1.slice(6, 4);
+        CPPA_CHECK(b4 == util::blob("blob", 4));
+        CPPA_CHECK(b4.data() == b1.data() + 6);
+        try {
+            b1.slice(6, 5);
+            CPPA_ERROR("slice out of range not detected");
+        }
+        catch (out_of_range&) { }
+    }
     return CPPA_TEST_RESULT;
 }
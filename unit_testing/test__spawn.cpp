@@ -660,6 +660,63 @@ int main() {
     CPPA_CHECK_EQUAL(res1, "wait4int");
     CPPA_CHECK_EQUAL(behavior_test<event_testee>(spawn<event_testee>()), "wait4int");
 
+    // event-based actors leave their handler normally when calling quit()
+    self->trap_exit(true);
+    auto quitter = factory::event_based([](bool* after_quit) {
+        self->become (
+            on(atom("quit")) >> [=]() {
+                self->quit(exit_reason::user_defined);
+                *after_quit = true;
+                reply(atom("after_quit"), *after_quit);
+            }
+        );
+    }).spawn();
+    self->link_to(quitter);
+    send(quitter, atom("quit"));
+    receive (
+        on(atom("after_quit"), arg_match) >> [&](bool value) {
+            CPPA_CHECK_EQUAL(true, value);
+        },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout in file " << __FILE__ << " in line " << __LINE__);
+        }
+    );
+    receive (
+        on(atom("EXIT"), arg_match) >> [&](uint32_t reason) {
+            CPPA_CHECK_EQUAL(exit_reason::user_defined, reason);
+            CPPA_CHECK(self->last_sender() == quitter);
+        },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout in file " << __FILE__ << " in line " << __LINE__);
+        }
+    );
+    await_all_others_done();
+    // receive() must not return into the handler of an event-based actor
+    auto receiver = factory::event_based([]() {
+        self->become (
+            on(atom("receive")) >> []() {
+                receive(others() >> []() { });
+                reply(atom("returned"));
+            }
+        );
+    }).spawn();
+    self->link_to(receiver);
+    send(receiver, atom("receive"));
+    receive (
+        on(atom("EXIT"), arg_match) >> [&](uint32_t reason) {
+            CPPA_CHECK_EQUAL(exit_reason::unallowed_function_call, reason);
+            CPPA_CHECK(self->last_sender() == receiver);
+        },
+        on(atom("returned")) >> [&]() {
+            CPPA_ERROR("receive() returned in an event-based actor");
+        },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout in file " << __FILE__ << " in line " << __LINE__);
+        }
+    );
+    await_all_others_done();
+    self->trap_exit(false);
+
     // create 20,000 actors linked to one single actor
     // and kill them all through killing the link
     auto twenty_thousand = spawn([]() {
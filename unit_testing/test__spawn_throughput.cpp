@@ -0,0 +1,212 @@
+#include <set>
+#include <new>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include "test.hpp"
+#include "cppa/cppa.hpp"
+#include "cppa/detail/memory.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+constexpr size_t num_actors = 50000;
+
+constexpr size_t num_events = 1000;
+
+// number of heap allocations performed by the calling thread
+thread_local size_t s_allocations = 0;
+
+// created by one thread and released by another, like the
+// events actor proxies send to the middleman
+struct cross_thread_event : memory_managed {
+    size_t value;
+    detail::instance_wrapper* outer_memory;
+    cross_thread_event(size_t x) : value(x), outer_memory(nullptr) { }
+};
+
+} // namespace <anonymous>
+
+// counts allocations of the calling thread; not inlined, since
+// GCC would otherwise warn about free() on results of new
+__attribute__((noinline)) void* operator new(size_t num_bytes) {
+    ++s_allocations;
+    auto result = malloc(num_bytes);
+    if (result == nullptr) throw bad_alloc();
+    return result;
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+namespace cppa { namespace detail {
+
+template<>
+struct use_recycling_pool<cross_thread_event> : std::true_type { };
+
+} } // namespace cppa::detail
+
+namespace {
+
+typedef chrono::high_resolution_clock clock_type;
+
+// handles exactly one request and quits afterwards
+struct one_shot : event_based_actor {
+    void init() {
+        become (
+            on(atom("ping")) >> [=]() {
+                reply(atom("pong"));
+                quit();
+            }
+        );
+    }
+};
+
+// replies its address and the number of received pings, the latter
+// must be 1 even if the instance re-uses memory of a previous actor
+struct counter : event_based_actor {
+    size_t count;
+    counter() : count(0) { }
+    void init() {
+        become (
+            on(atom("ping")) >> [=]() {
+                auto addr = reinterpret_cast<std::uintptr_t>(this);
+                reply(atom("pong"), static_cast<uint64_t>(addr), ++count);
+                quit();
+            }
+        );
+    }
+};
+
+// spawns num_actors counters and returns their addresses,
+// sets all_reset to false if any counter was not initialized
+set<uint64_t> spawn_counters(bool& all_reset) {
+    vector<actor_ptr> actors;
+    for (size_t i = 0; i < num_actors / 10; ++i) {
+        actors.push_back(spawn<counter>());
+    }
+    for (auto& a : actors) send(a, atom("ping"));
+    set<uint64_t> result;
+    size_t pongs = 0;
+    receive_for(pongs, actors.size()) (
+        on(atom("pong"), arg_match) >> [&](uint64_t addr, size_t count) {
+            result.insert(addr);
+            if (count != 1) all_reset = false;
+        }
+    );
+    actors.clear();
+    await_all_others_done();
+    return result;
+}
+
+// sends one ping to each actor and returns the number of received pongs
+size_t ping_all(const vector<actor_ptr>& actors) {
+    for (auto& a : actors) send(a, atom("ping"));
+    size_t pongs = 0;
+    receive_for(pongs, actors.size()) (
+        on(atom("pong")) >> []() { }
+    );
+    return pongs;
+}
+
+template<typename F>
+size_t measure(const char* what, F spawn_fun) {
+    auto t0 = clock_type::now();
+    auto actors = spawn_fun();
+    auto t1 = clock_type::now();
+    auto pongs = ping_all(actors);
+    actors.clear();
+    await_all_others_done();
+    auto t2 = clock_type::now();
+    auto spawn_us = chrono::duration_cast<chrono::microseconds>(t1 - t0);
+    auto total_us = chrono::duration_cast<chrono::microseconds>(t2 - t0);
+    cout << what << ": spawned " << num_actors << " actors in "
+         << spawn_us.count() / 1000 << "ms ("
+         << (num_actors * 1000000) / max<long long>(spawn_us.count(), 1)
+         << " actors/s), spawn + request + exit took "
+         << total_us.count() / 1000 << "ms" << endl;
+    return pongs;
+}
+
+// creates num_events events, releases them in another thread and
+// returns the number of heap allocations needed to create them
+size_t create_and_release_events() {
+    vector<cross_thread_event*> events;
+    events.reserve(num_events);
+    auto before = s_allocations;
+    for (size_t i = 0; i < num_events; ++i) {
+        events.push_back(detail::memory::create<cross_thread_event>(i));
+    }
+    auto result = s_allocations - before;
+    thread([&] {
+        for (auto e : events) detail::memory::dispose(e);
+    }).join();
+    return result;
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test__spawn_throughput);
+    auto pongs = measure("spawn<one_shot>", [] {
+        vector<actor_ptr> result;
+        result.reserve(num_actors);
+        for (size_t i = 0; i < num_actors; ++i) {
+            result.push_back(spawn<one_shot>());
+        }
+        return result;
+    });
+    CPPA_CHECK_EQUAL(num_actors, pongs);
+    pongs = measure("factory::event_based", [] {
+        auto f = factory::event_based([]() {
+            self->become (
+                on(atom("ping")) >> []() {
+                    reply(atom("pong"));
+                    self->quit();
+                }
+            );
+        });
+        vector<actor_ptr> result;
+        result.reserve(num_actors);
+        for (size_t i = 0; i < num_actors; ++i) {
+            result.push_back(f.spawn());
+        }
+        return result;
+    });
+    CPPA_CHECK_EQUAL(num_actors, pongs);
+    set<actor_id> ids;
+    pongs = measure("spawn_n<one_shot>", [&] {
+        auto result = spawn_n<one_shot>(num_actors);
+        for (auto& a : result) ids.insert(a->id());
+        return result;
+    });
+    CPPA_CHECK_EQUAL(num_actors, pongs);
+    // actor IDs must be unique even though they are handed out in blocks
+    CPPA_CHECK_EQUAL(num_actors, ids.size());
+    // memory of actors released by worker threads is used for new actors
+    bool all_reset = true;
+    auto first = spawn_counters(all_reset);
+    auto second = spawn_counters(all_reset);
+    size_t reused = 0;
+    for (auto addr : second) reused += first.count(addr);
+    cout << "recycled " << reused << " of " << second.size()
+         << " actor instances" << endl;
+    CPPA_CHECK(reused > 0);
+    CPPA_CHECK(all_reset);
+    // events released by another thread are used for new events
+    auto allocations = create_and_release_events();
+    CPPA_CHECK(allocations > 0);
+    allocations = create_and_release_events();
+    cout << "created " << num_events << " events using "
+         << allocations << " allocations" << endl;
+    CPPA_CHECK_EQUAL(0, allocations);
+    shutdown();
+    return CPPA_TEST_RESULT;
+}
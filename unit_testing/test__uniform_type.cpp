@@ -85,6 +85,7 @@ int main() {
         "@group",              // cppa::group_ptr
         "@channel",            // cppa::channel_ptr
         "@process_info",       // cppa::intrusive_ptr<cppa::process_information>
+        "@blob",               // cppa::util::blob
         "cppa::util::duration"
     };
     // holds the type names we see at runtime
@@ -182,5 +183,18 @@ int main() {
     CPPA_CHECK(arr3[1] == uniform_type_info::from("@u16"));
     CPPA_CHECK(uniform_type_info::from("@u16") == uniform_typeid<std::uint16_t>());
 
+    // each type has a unique id and repeated lookups yield the same instance
+    std::set<std::uint32_t> ids;
+    for (auto tinfo : types) {
+        ids.insert(tinfo->type_id());
+        CPPA_CHECK(uniform_type_info::from_id(tinfo->type_id()) == tinfo);
+    }
+    CPPA_CHECK_EQUAL(types.size(), ids.size());
+    for (int i = 0; i < 2; ++i) {
+        CPPA_CHECK(uniform_typeid<std::string>() == uniform_type_info::from("@str"));
+        CPPA_CHECK(uniform_typeid<long>() == uniform_typeid<std::int64_t>());
+        CPPA_CHECK(uniform_typeid<foo>() == uniform_type_info::from("@_::foo"));
+    }
+
     return CPPA_TEST_RESULT;
 }
@@ -0,0 +1,165 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "test.hpp"
+#include "cppa/cppa.hpp"
+#include "cppa/binary_format.hpp"
+#include "cppa/binary_serializer.hpp"
+#include "cppa/binary_deserializer.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+constexpr size_t num_rounds = 20000;
+
+typedef chrono::high_resolution_clock clock_type;
+
+struct measurement {
+    size_t bytes;           // bytes per round
+    long long encode_us;
+    long long decode_us;
+    bool equal;             // all messages survived the round trip
+};
+
+// messages with mostly small integers as seen in typical
+// request / response protocols
+vector<any_tuple> sample_messages() {
+    vector<int32_t> ints;
+    for (int32_t i = -50; i < 50; ++i) ints.push_back(i);
+    return {
+        make_any_tuple(atom("get"), uint64_t{42}, string("key")),
+        make_any_tuple(atom("put"), string("key"), string("value"), 7),
+        make_any_tuple(atom("result"), int64_t{-1}, uint32_t{3}),
+        make_any_tuple(atom("tick"), uint64_t{1234567}, 0.5),
+        make_any_tuple(atom("batch"), ints),
+        make_any_tuple(uint16_t{80}, int16_t{-3}, int8_t{1}, uint8_t{200})
+    };
+}
+
+measurement run(const char* what, uint32_t format,
+                const vector<any_tuple>& msgs) {
+    measurement result{0, 0, 0, true};
+    util::buffer buf;
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < num_rounds; ++i) {
+        buf.clear();
+        binary_serializer bs(&buf);
+        bs.format(format);
+        for (auto& msg : msgs) bs << msg;
+    }
+    auto t1 = clock_type::now();
+    result.bytes = buf.size();
+    for (size_t i = 0; i < num_rounds; ++i) {
+        binary_deserializer bd(buf.data(), buf.size());
+        bd.format(format);
+        for (auto& msg : msgs) {
+            any_tuple tmp;
+            uniform_typeid<any_tuple>()->deserialize(&tmp, &bd);
+            if (!(tmp == msg)) result.equal = false;
+        }
+    }
+    auto t2 = clock_type::now();
+    result.encode_us = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
+    result.decode_us = chrono::duration_cast<chrono::microseconds>(t2 - t1).count();
+    cout << what << ": " << result.bytes << " bytes for " << msgs.size()
+         << " messages, encoded " << num_rounds << " times in "
+         << result.encode_us / 1000 << "ms, decoded in "
+         << result.decode_us / 1000 << "ms" << endl;
+    return result;
+}
+
+// two structs with the same layout, announced member-wise
+// and with announce_fused respectively
+struct sample_a { int32_t id; double value; uint16_t flags; };
+struct sample_b { int32_t id; double value; uint16_t flags; };
+
+template<typename T>
+bool equal(const T& lhs, const T& rhs) {
+    return    lhs.id == rhs.id
+           && lhs.value == rhs.value
+           && lhs.flags == rhs.flags;
+}
+
+bool operator==(const sample_a& lhs, const sample_a& rhs) {
+    return equal(lhs, rhs);
+}
+
+bool operator==(const sample_b& lhs, const sample_b& rhs) {
+    return equal(lhs, rhs);
+}
+
+template<typename T>
+bool run_structs(const char* what) {
+    vector<T> samples;
+    for (int32_t i = 0; i < 1000; ++i) {
+        samples.push_back(T{i, i * 0.5, static_cast<uint16_t>(i)});
+    }
+    auto uti = uniform_typeid<vector<T>>();
+    util::buffer buf;
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < num_rounds / 100; ++i) {
+        buf.clear();
+        binary_serializer bs(&buf);
+        uti->serialize(&samples, &bs);
+    }
+    auto t1 = clock_type::now();
+    vector<T> tmp;
+    for (size_t i = 0; i < num_rounds / 100; ++i) {
+        binary_deserializer bd(buf.data(), buf.size());
+        uti->deserialize(&tmp, &bd);
+    }
+    auto t2 = clock_type::now();
+    cout << what << ": " << buf.size() << " bytes for "
+         << samples.size() << " structs, encoded " << (num_rounds / 100)
+         << " times in "
+         << chrono::duration_cast<chrono::milliseconds>(t1 - t0).count()
+         << "ms, decoded in "
+         << chrono::duration_cast<chrono::milliseconds>(t2 - t1).count()
+         << "ms" << endl;
+    return tmp == samples;
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test__wire_format);
+    announce<vector<int32_t>>();
+    auto msgs = sample_messages();
+    auto fixed = run("fixed-size integers", default_binary_format, msgs);
+    auto compact = run("varint integers",
+                       default_binary_format | varint_integers, msgs);
+    CPPA_CHECK(fixed.equal);
+    CPPA_CHECK(compact.equal);
+    CPPA_CHECK(compact.bytes < fixed.bytes);
+    announce<sample_a>(&sample_a::id, &sample_a::value, &sample_a::flags);
+    announce_fused<sample_b>(&sample_b::id, &sample_b::value,
+                             &sample_b::flags);
+    announce<vector<sample_a>>();
+    announce<vector<sample_b>>();
+    CPPA_CHECK(run_structs<sample_a>("announce"));
+    CPPA_CHECK(run_structs<sample_b>("announce_fused"));
+    // zigzag encoding keeps small negative values small
+    util::buffer buf;
+    binary_serializer bs(&buf);
+    bs.format(varint_integers);
+    bs.write(int64_t{-1});
+    bs.write(int32_t{63});
+    bs.write(int32_t{-64});
+    CPPA_CHECK_EQUAL(3, buf.size());
+    bs.write(numeric_limits<int64_t>::min());
+    bs.write(numeric_limits<uint64_t>::max());
+    binary_deserializer bd(buf.data(), buf.size());
+    bd.format(varint_integers);
+    CPPA_CHECK_EQUAL(-1, bd.read<int64_t>());
+    CPPA_CHECK_EQUAL(63, bd.read<int32_t>());
+    CPPA_CHECK_EQUAL(-64, bd.read<int32_t>());
+    CPPA_CHECK(bd.read<int64_t>() == numeric_limits<int64_t>::min());
+    CPPA_CHECK(bd.read<uint64_t>() == numeric_limits<uint64_t>::max());
+    shutdown();
+    return CPPA_TEST_RESULT;
+}